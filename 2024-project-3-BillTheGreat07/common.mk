@@ -50,8 +50,9 @@ override CFLAGS += -g -Wall -Werror -MMD -I$(INCLUDE)
 
 # Linker options
 #   -lm        Link με τη math library
+#   -lpthread  Link με τη βιβλιοθήκη pthreads (για το background rehash του ADTMap)
 #
-LDFLAGS += -lm
+LDFLAGS += -lm -lpthread
 
 # Αν στα targets με τα οποία έχει κληθεί το make (μεταβλητή MAKECMDGOALS) υπάρχει κάποιο
 # coverage*, τότε προσθέτουμε το --coverage στα compile & link flags
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////
+//
+// ADT ConcurrentMap
+//
+// Map που μπορεί να χρησιμοποιείται ταυτόχρονα από πολλά threads
+// χωρίς εξωτερικό κλείδωμα. Οι αναζητήσεις δεν παίρνουν κανένα lock,
+// οπότε κλιμακώνονται με το πλήθος των threads.
+//
+///////////////////////////////////////////////////////////
+
+#pragma once // #include το πολύ μία φορά
+
+#include "common_types.h"
+#include "ADTMap.h"				// για τον τύπο HashFunc και τις hash_string, hash_int, hash_pointer
+
+
+// Ενα concurrent map αναπαριστάται από τον τύπο ConcurrentMap
+
+typedef struct concurrent_map* ConcurrentMap;
+
+
+// Δημιουργεί και επιστρέφει ένα concurrent map, στο οποίο τα keys συγκρίνονται με τη compare
+// και κατακερματίζονται με τη hash_function.
+//
+// Σε αντίθεση με το Map, το ConcurrentMap δεν καταστρέφει ποτέ keys ή values: ένα thread μπορεί να
+// διαβάζει (να καλεί τη compare σε) ένα key την ίδια στιγμή που ένα άλλο το αφαιρεί. Οπότε τα keys
+// που αφαιρούνται δεν πρέπει να αποδεσμεύονται όσο κάποιο thread μπορεί ακόμα να κάνει αναζητήσεις.
+//
+// Οποιοσδήποτε Pointer μπορεί να είναι key, και NULL ή ακέραιοι αποθηκευμένοι μέσα στον Pointer.
+
+ConcurrentMap concurrent_map_create(CompareFunc compare, HashFunc hash_function);
+
+// Επιστρέφει τον αριθμό στοιχείων που περιέχει το map. Αν άλλα threads τροποποιούν ταυτόχρονα
+// το map, το αποτέλεσμα είναι προσεγγιστικό.
+
+int concurrent_map_size(ConcurrentMap map);
+
+// Επιστρέφει πόσα bytes δεσμεύουν οι πίνακες του map, μαζί με όσους δε χρησιμοποιούνται πλέον αλλά
+// κρατιούνται μέχρι το concurrent_map_destroy (ώστε να μην τους διαβάζει κάποια αναζήτηση αφού αποδεσμευτούν).
+
+size_t concurrent_map_memory(ConcurrentMap map);
+
+// Προσθέτει το κλειδί key με τιμή value. Αν υπάρχει κλειδί ισοδύναμο με key, τα παλιά key & value αντικαθίσταται από τα νέα.
+
+void concurrent_map_insert(ConcurrentMap map, Pointer key, Pointer value);
+
+// Αφαιρεί το κλειδί που είναι ισοδύναμο με key από το map, αν υπάρχει.
+// Επιστρέφει true αν βρέθηκε τέτοιο κλειδί, διαφορετικά false.
+
+bool concurrent_map_remove(ConcurrentMap map, Pointer key);
+
+// Επιστρέφει την τιμή που έχει αντιστοιχιστεί στο συγκεκριμένο key, ή NULL αν το key δεν υπάρχει στο map.
+// Δεν παίρνει κανένα lock.
+
+Pointer concurrent_map_find(ConcurrentMap map, Pointer key);
+
+// Ελευθερώνει όλη τη μνήμη που δεσμεύει το map (όχι τα keys/values).
+// Πρέπει να καλείται όταν κανένα άλλο thread δε χρησιμοποιεί πλέον το map.
+
+void concurrent_map_destroy(ConcurrentMap map);
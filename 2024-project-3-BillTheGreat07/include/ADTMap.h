@@ -10,6 +10,9 @@
 
 #include "common_types.h"
 
+#include <stdint.h>
+#include <stddef.h>
+
 
 // Ενα map αναπαριστάται από τον τύπο Map
 
@@ -85,6 +88,11 @@ Pointer map_node_key(Map map, MapNode node);
 
 Pointer map_node_value(Map map, MapNode node);
 
+// Αλλάζει το περιεχόμενο του κόμβου node σε value. Αν υπάρχει destroy_value, καλείται για το
+// προηγούμενο περιεχόμενο (εφόσον είναι διαφορετικό από το value και όχι NULL).
+
+void map_node_set_value(Map map, MapNode node, Pointer value);
+
 // Βρίσκει και επιστρέφεο τον κόμβο που έχει αντιστοιχιστεί στο κλειδί key,
 // ή MAP_EOF αν το κλειδί δεν υπάρχει στο map.
 
@@ -109,3 +117,168 @@ uint hash_pointer(Pointer value);		// Χρήση όταν το key είναι po
 // τιμή που επιστρέφει η συνάρτηση κατακερματισμού, διαφορετικά η συμπεριφορά είναι μη ορισμένη.
 
 void map_set_hash_function(Map map, HashFunc hash_func);
+
+// Ορίζει το seed των hash_string, hash_int και hash_pointer για το συγκεκριμένο map (δεν επηρεάζει
+// συναρτήσεις κατακερματισμού του χρήστη). Κάθε map ξεκινάει με ένα seed που επιλέγεται τυχαία μία φορά
+// για όλο το πρόγραμμα, ώστε keys επιλεγμένα από κάποιον επιτιθέμενο να μην μπορούν να προκαλέσουν
+// συγκρούσεις. Μπορεί να κληθεί οποτεδήποτε, αν το map δεν είναι κενό τα στοιχεία του κάνουν rehash.
+
+void map_set_hash_seed(Map map, uint64_t seed);
+
+// Επιστρέφει το hash code του key, με τη συνάρτηση κατακερματισμού (και το seed) του map.
+// Το αποτέλεσμα μπορεί να χρησιμοποιηθεί στις map_*_hashed, σε αυτό ή σε οποιοδήποτε άλλο map
+// με την ίδια συνάρτηση κατακερματισμού και seed, ώστε να μη γίνεται ξανά hashing του key σε κάθε λειτουργία.
+
+uint map_hash(Map map, Pointer key);
+
+// Όπως οι map_insert, map_remove και map_find, αλλά με το hash code του key ήδη υπολογισμένο (από την map_hash).
+// Το hash πρέπει να είναι ίσο με την τιμή της συνάρτησης κατακερματισμού του map για το key,
+// διαφορετικά η συμπεριφορά είναι μη ορισμένη.
+
+void map_insert_hashed(Map map, Pointer key, Pointer value, uint hash);
+
+bool map_remove_hashed(Map map, Pointer key, uint hash);
+
+Pointer map_find_hashed(Map map, Pointer key, uint hash);
+
+// Τρόποι επιλογής του μεγέθους του hash table
+
+typedef enum {
+	MAP_SIZE_PRIME,				// Πρώτοι αριθμοί (default), η θέση ενός key είναι hash % capacity
+	MAP_SIZE_POWER_OF_TWO		// Δυνάμεις του 2, η θέση υπολογίζεται με Fibonacci hashing και mask, χωρίς διαίρεση
+} MapSizing;
+
+// Ορίζει τον τρόπο επιλογής του μεγέθους του hash table για το συγκεκριμένο map.
+// Πρέπει να κληθεί αμέσως μετά την map_create, όσο το map είναι κενό.
+
+void map_set_sizing(Map map, MapSizing sizing);
+
+// Όπως η map_create, αλλά το map δημιουργείται με αρκετό χώρο ώστε να χωράει expected_entries στοιχεία χωρίς κανένα rehash.
+
+Map map_create_with_capacity(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value, int expected_entries);
+
+// Δημιουργεί ένα map με inline αποθήκευση: κάθε key (key_size bytes) και value (value_size bytes) αντιγράφεται
+// μέσα στον πίνακα του map, οπότε ο caller δε χρειάζεται να δεσμεύσει μνήμη για αυτά (ούτε destroy_key/destroy_value).
+// Η map_insert αντιγράφει τα περιεχόμενα των key/value (value NULL = μηδενικά bytes), και οι map_find,
+// map_node_key και map_node_value επιστρέφουν δείκτες μέσα στον πίνακα, που είναι έγκυροι μέχρι την επόμενη
+// λειτουργία στο map. Με value_size 0 το map λειτουργεί ως σύνολο (η map_find επιστρέφει != NULL για τα keys του).
+
+Map map_create_inline(size_t key_size, size_t value_size, CompareFunc compare);
+
+// Όπως η map_insert για keys που είναι strings, αλλά το map αποθηκεύει ένα δικό του αντίγραφο του key, σε ένα
+// εσωτερικό arena (μεγάλα blocks μνήμης που γεμίζουν διαδοχικά). Ο caller μπορεί να αλλάξει ή να αποδεσμεύσει
+// το key αμέσως μετά την κλήση. Τα αντίγραφα αποδεσμεύονται όλα μαζί στην map_destroy, και όσα ανήκουν σε keys
+// που έχουν διαγραφεί ανακτώνται στο επόμενο rehash (όπου τα υπόλοιπα αντιγράφονται σε νέο arena).
+// Το map δεν πρέπει να έχει destroy_key ούτε inline αποθήκευση, και όλα τα keys του πρέπει να είναι strings.
+
+void map_insert_copy_string(Map map, const char* key, Pointer value);
+
+// Μεγαλώνει (αν χρειάζεται) τον πίνακα ώστε να χωράει expected_entries στοιχεία χωρίς κανένα rehash,
+// πχ πριν από μαζική εισαγωγή γνωστού πλήθους στοιχείων. Μέχρι το επόμενο map_shrink_to_fit (ή map_reserve),
+// ο πίνακας δε μικραίνει αυτόματα κάτω από αυτό το μέγεθος. Με expected_entries 0 απλά ακυρώνεται τυχόν
+// προηγούμενη κράτηση, χωρίς να αλλάξει ο πίνακας.
+
+void map_reserve(Map map, int expected_entries);
+
+// Όπως η map_reserve, αλλά χωρίς κράτηση: ο πίνακας μεγαλώνει (αν χρειάζεται) ώστε να χωράει expected_entries
+// στοιχεία, και μπορεί να μικρύνει ξανά αυτόματα μετά από διαγραφές, σαν να είχε μεγαλώσει μόνος του.
+
+void map_grow(Map map, int expected_entries);
+
+// Βρίσκει τον κόμβο του key, με ένα μόνο hashing και μία αναζήτηση στον πίνακα. Αν το key δεν υπάρχει,
+// εισάγεται με value NULL, ώστε ο caller να γράψει την τιμή με map_node_set_value. Στο inserted (αν δεν είναι NULL)
+// αποθηκεύεται αν έγινε εισαγωγή. Αν το key υπήρχε ήδη, το map κρατάει το παλιό key και δεν αποκτά το key που δόθηκε.
+// Ο κόμβος που επιστρέφεται είναι έγκυρος μέχρι την επόμενη λειτουργία στο map.
+
+MapNode map_find_or_insert(Map map, Pointer key, bool* inserted);
+
+// Συνάρτηση που δέχεται την τρέχουσα τιμή ενός key (NULL αν το key είναι καινούριο) και επιστρέφει τη νέα
+
+typedef Pointer (*UpdateFunc)(Pointer value);
+
+// Αντικαθιστά την τιμή του key με update(τρέχουσα τιμή), εισάγοντας το key αν δεν υπάρχει (όπως η map_find_or_insert).
+
+void map_update(Map map, Pointer key, UpdateFunc update);
+
+// Όπως η map_update, με το hash code του key ήδη υπολογισμένο (όπως οι map_*_hashed παραπάνω).
+
+void map_update_hashed(Map map, Pointer key, UpdateFunc update, uint hash);
+
+// Αναζητά n keys μαζί, και αποθηκεύει στο values[i] την τιμή του keys[i] (ή NULL αν δεν υπάρχει), όπως η map_find.
+// Οι προσβάσεις στη μνήμη για όλα τα keys γίνονται παράλληλα (prefetching), οπότε σε μεγάλα maps που δε χωράνε
+// στο cache είναι αρκετά γρηγορότερη από n κλήσεις της map_find.
+
+void map_find_many(Map map, Pointer* keys, int n, Pointer* values);
+
+// Εισάγει n ζευγάρια (keys[i], values[i]), όπως n κλήσεις της map_insert, με prefetching όπως η map_find_many.
+
+void map_insert_many(Map map, Pointer* keys, Pointer* values, int n);
+
+// Εισάγει n ζευγάρια (keys[i], values[i]), όπως η map_insert_many, χρησιμοποιώντας έως threads threads. Ο πίνακας
+// μεγαλώνει εκ των προτέρων (όπως με map_grow) και
+// χωρίζεται σε μία περιοχή ανά thread, ανάλογα με τη θέση στην οποία κάνει hash κάθε key, οπότε κάθε thread
+// γεμίζει μόνο τη δική του περιοχή, χωρίς κανένα συγχρονισμό.
+// Η παράλληλη εισαγωγή γίνεται μόνο αν το map είναι κενό, διαφορετικά (ή για λίγα στοιχεία) είναι ίδια με
+// την map_insert_many. Η συνάρτηση κατακερματισμού, η compare και οι destroy_key/destroy_value (για διπλά keys)
+// μπορεί να κληθούν ταυτόχρονα από πολλά threads. Το ίδιο το map συνεχίζει να μην είναι thread-safe.
+
+void map_build_parallel(Map map, Pointer* keys, Pointer* values, int n, int threads);
+
+// Μικραίνει τον πίνακα στο μικρότερο μέγεθος που χωράει άνετα τα τρέχοντα στοιχεία, αφαιρώντας και
+// όλα τα DELETED κελιά. Το map μικραίνει και αυτόματα μετά από διαγραφές, σταδιακά, η συνάρτηση αυτή
+// είναι χρήσιμη όταν γνωρίζουμε ότι μόλις ολοκληρώθηκε ένας μεγάλος αριθμός διαγραφών.
+
+void map_shrink_to_fit(Map map);
+
+// Το rehash γίνεται σταδιακά (incremental): κάθε map_insert και map_remove μεταφέρει λίγα κελιά
+// από τον παλιό πίνακα στον νέο. Η map_set_rehash_budget ορίζει πόσα (default 2, 0 για καμία μεταφορά).
+// Η μεταφορά μετακινεί κόμβους, οπότε όσο διατρέχουμε το map με map_first/map_next δεν πρέπει να
+// καλούμε map_insert/map_remove, εκτός αν έχουμε ορίσει budget 0.
+
+void map_set_rehash_budget(Map map, int steps);
+
+// Ορίζει πόσα κελιά μεταφέρει κάθε map_find (και κάθε key της map_find_many), ώστε ένα map που μετά από
+// rehash δέχεται σχεδόν μόνο αναζητήσεις να μην ψάχνει για πάντα και στους δύο πίνακες (default 1). Με budget > 0
+// η map_find μετακινεί κόμβους, οπότε όπως και η map_insert δεν πρέπει να καλείται κατά τη διάσχιση του map.
+// Με steps 0 οι αναζητήσεις δεν τροποποιούν καθόλου το map (ούτε τα στατιστικά του), και μπορούν να γίνονται
+// και κατά τη διάσχισή του· η μεταφορά τότε προχωράει μόνο με τροποποιήσεις και με map_rehash_step.
+// Η map_find_node δε μεταφέρει ποτέ κελιά.
+
+void map_set_find_rehash_budget(Map map, int steps);
+
+// Μεταφέρει έως steps κελιά του παλιού πίνακα (πχ σε περιόδους αδράνειας, ώστε το rehash να ολοκληρωθεί νωρίτερα).
+// Επιστρέφει true αν δεν υπάρχει πλέον rehash σε εξέλιξη.
+
+bool map_rehash_step(Map map, int steps);
+
+// Ενεργοποιεί (ή απενεργοποιεί) το background rehash. Σε αυτό, ο επόμενος (μεγαλύτερος) πίνακας δεσμεύεται
+// και αρχικοποιείται από βοηθητικό thread πριν χρειαστεί, και ο παλιός πίνακας αποδεσμεύεται επίσης από
+// βοηθητικό thread, ώστε οι λειτουργίες που προκαλούν rehash να μην πληρώνουν το κόστος O(capacity).
+// Η μεταφορά των στοιχείων παραμένει incremental, στις λειτουργίες του map, ώστε οι κόμβοι (MapNode)
+// να μη μετακινούνται ποτέ παρά μόνο μέσα σε κλήσεις του map. Το ίδιο το map δεν είναι thread-safe.
+
+void map_set_background_rehash(Map map, bool background);
+
+// Στατιστικά για τη λειτουργία του hash table
+
+typedef struct {
+	int grows;					// Πόσα rehash έγιναν προς μεγαλύτερο πίνακα
+	int purges;					// Πόσα rehash έγιναν στο ίδιο (ή μικρότερο) μέγεθος, επειδή ο πίνακας γέμισε κυρίως με DELETED
+	int shrinks;				// Πόσα rehash έγιναν προς μικρότερο πίνακα, μετά από διαγραφές ή map_shrink_to_fit
+	long old_lookups;			// Πόσες αναζητήσεις χρειάστηκε να ψάξουν και στον παλιό πίνακα (στη διάρκεια rehash),
+								// εκτός από της map_find_node και της map_find με find rehash budget 0
+	long old_hits;				// Πόσες από αυτές βρήκαν το key στον παλιό πίνακα
+	int longest_probe;			// Τα περισσότερα κελιά που εξέτασε μια εισαγωγή, από το τελευταίο rehash
+	int floods;					// Πόσες φορές εντοπίστηκε hash flooding (πολύ μεγάλες αλυσίδες) και άλλαξε η θέση των keys
+} MapStats;
+
+// Σημείωση για το hash flooding: όταν μια εισαγωγή εξετάσει πολλά κελιά, το map ανακατεύει τις θέσεις των keys
+// με ένα τυχαίο salt και ξαναχτίζει τον πίνακα. Αυτό διαχωρίζει keys που συγκρούονται μόνο στη θέση του πίνακα
+// (πχ επειδή ο επιτιθέμενος γνωρίζει το sizing), αλλά όχι keys με ακριβώς το ίδιο hash code, που παραμένουν
+// σε μία αλυσίδα (με αναζήτηση O(πλήθος τους)). Τέτοια keys ο επιτιθέμενος μπορεί να τα επιλέξει μόνο αν η
+// συνάρτηση κατακερματισμού δεν έχει τυχαίο seed, οπότε για keys από μη έμπιστη πηγή πρέπει να χρησιμοποιούνται
+// οι hash_string, hash_int, hash_pointer (με το seed του map) και όχι δική μας συνάρτηση χωρίς seed.
+
+// Επιστρέφει τα στατιστικά του map από τη δημιουργία του
+
+MapStats map_stats(Map map);
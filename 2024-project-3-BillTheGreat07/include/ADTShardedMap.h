@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////
+//
+// ADT ShardedMap
+//
+// Map χωρισμένο σε N ανεξάρτητα Map (shards). Κάθε key ανήκει σε
+// ένα shard, που επιλέγεται από τα υψηλά bits του hash code του.
+//
+// Χρησιμοποιείται με δύο τρόπους, για παράλληλη επεξεργασία (πχ μέτρηση):
+// - Ένα ShardedMap ανά thread (χωρίς locks), τα οποία στο τέλος συγχωνεύονται
+//   με sharded_map_merge / sharded_map_merge_into.
+// - Ένα κοινό ShardedMap με lock ανά shard, οπότε threads που χρησιμοποιούν
+//   διαφορετικά shards δεν περιμένουν το ένα το άλλο.
+//
+///////////////////////////////////////////////////////////
+
+#pragma once // #include το πολύ μία φορά
+
+#include "common_types.h"
+#include "ADTMap.h"
+
+
+// Ενα sharded map αναπαριστάται από τον τύπο ShardedMap
+
+typedef struct sharded_map* ShardedMap;
+
+
+// Δημιουργεί και επιστρέφει ένα sharded map με shards shards (στρογγυλοποιούνται στην επόμενη δύναμη του 2),
+// στο οποίο τα keys συγκρίνονται με τη compare και κατακερματίζονται με τη hash_function.
+// Αν locked == true, κάθε shard προστατεύεται από δικό του lock και όλες οι λειτουργίες μπορούν να
+// καλούνται ταυτόχρονα από πολλά threads. Διαφορετικά το map χρησιμοποιείται από ένα thread κάθε φορά.
+// Αν destroy_key ή/και destroy_value != NULL, καλούνται κάθε φορά που αφαιρείται ένα στοιχείο (όπως στο Map).
+
+ShardedMap sharded_map_create(int shards, bool locked, CompareFunc compare, HashFunc hash_function,
+	DestroyFunc destroy_key, DestroyFunc destroy_value);
+
+// Επιστρέφει τον αριθμό στοιχείων που περιέχει το map (σε locked map, με ταυτόχρονες τροποποιήσεις, προσεγγιστικά).
+
+int sharded_map_size(ShardedMap map);
+
+// Όπως οι map_insert, map_remove, map_find και map_update, στο shard του key.
+
+void sharded_map_insert(ShardedMap map, Pointer key, Pointer value);
+
+bool sharded_map_remove(ShardedMap map, Pointer key);
+
+Pointer sharded_map_find(ShardedMap map, Pointer key);
+
+void sharded_map_update(ShardedMap map, Pointer key, UpdateFunc update);
+
+// Συνάρτηση που συνδυάζει την τιμή target_value ενός key με την τιμή source_value του ίδιου key
+// από άλλο map, και επιστρέφει τη νέα τιμή (πχ το άθροισμα δύο μετρητών)
+
+typedef Pointer (*MergeFunc)(Pointer target_value, Pointer source_value);
+
+// Μεταφέρει όλα τα στοιχεία του source στο target, και αδειάζει το source. Αν ένα key υπάρχει ήδη στο target,
+// η τιμή του γίνεται merge(τιμή στο target, τιμή στο source) (ή η τιμή του source αν merge == NULL), το target κρατάει
+// το δικό του key, και το key του source καταστρέφεται με τη destroy_key του source (όπως και η τιμή του, αν η
+// merge δεν την επέστρεψε). Τα δύο maps πρέπει να έχουν το ίδιο πλήθος shards και την ίδια hash_function.
+//
+// Τα shards μεταφέρονται ένα-ένα, οπότε αν το target είναι locked, πολλά threads μπορούν να συγχωνεύουν ταυτόχρονα
+// τα δικά τους source στο ίδιο target, περιμένοντας μόνο όταν συγχωνεύουν το ίδιο shard.
+
+void sharded_map_merge(ShardedMap target, ShardedMap source, MergeFunc merge);
+
+// Όπως η sharded_map_merge, αλλά τα στοιχεία του source μεταφέρονται σε ένα απλό Map (πχ για το τελικό αποτέλεσμα).
+// Αν το target είναι κενό, ο πίνακάς του μεγαλώνει εκ των προτέρων, ώστε η μεταφορά να μην προκαλεί κανένα rehash
+// (χωρίς όμως να μένει κράτηση όπως με map_reserve, οπότε μπορεί αργότερα να μικρύνει αυτόματα). Το ίδιο ισχύει
+// για κάθε κενό shard του target της sharded_map_merge.
+
+void sharded_map_merge_into(ShardedMap source, Map target, MergeFunc merge);
+
+// Ελευθερώνει όλη τη μνήμη που δεσμεύει το map.
+
+void sharded_map_destroy(ShardedMap map);
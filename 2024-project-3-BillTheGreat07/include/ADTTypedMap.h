@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////
+//
+// Typed Map
+//
+// Εκδοχή του ADT Map για συγκεκριμένους τύπους key/value, που παράγεται από το macro DEFINE_MAP.
+// Τα keys και τα values αποθηκεύονται απευθείας μέσα στους κόμβους (όχι ως Pointer), και οι
+// συναρτήσεις hash/σύγκρισης καλούνται απευθείας (όχι μέσω function pointers), οπότε ο compiler
+// μπορεί να τις κάνει inline.
+//
+// Ο αλγόριθμος είναι ίδιος με αυτόν του UsingHashTable/ADTMap.c: linear probing με EMPTY/OCCUPIED/DELETED
+// κόμβους και incremental rehash (σε κάθε λειτουργία μεταφέρονται λίγα κελιά από τον παλιό πίνακα στον
+// καινούργιο), με τη διαφορά ότι κάθε κόμβος έχει και το hash code του key. Τα μεγέθη είναι δυνάμεις του 2 με Fibonacci hashing
+// (όπως το MAP_SIZE_POWER_OF_TWO). Δεν υποστηρίζονται seed, salt, shrink και background rehash.
+//
+// Παράδειγμα:
+//
+//   DEFINE_MAP(IntIntMap, int, int, typed_map_hash_int, typed_map_equal_int)
+//
+//   IntIntMap* map = IntIntMap_create();
+//   IntIntMap_insert(map, 1, 10);
+//   int* value = IntIntMap_find(map, 1);		// NULL αν το key δεν υπάρχει
+//   IntIntMap_destroy(map);
+//
+///////////////////////////////////////////////////////////
+
+#pragma once // #include το πολύ μία φορά
+
+#include "common_types.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// Οι σταθερές έχουν την ίδια σημασία με τις αντίστοιχες του UsingHashTable/ADTMap.c
+
+#define TYPED_MAP_INITIAL_CAPACITY 64
+#define TYPED_MAP_FIBONACCI_MULTIPLIER 2654435769u
+#define TYPED_MAP_MAX_LOAD_FACTOR 0.5
+#define TYPED_MAP_REHASH_BUDGET 2
+
+enum { TYPED_MAP_EMPTY, TYPED_MAP_OCCUPIED, TYPED_MAP_DELETED };
+
+
+// Συναρτήσεις κατακερματισμού και σύγκρισης για τους συνηθισμένους τύπους.
+// Η hash_fn δέχεται ένα key και επιστρέφει uint, η equal_fn δέχεται δύο keys και επιστρέφει bool.
+
+static inline uint typed_map_hash_int(int key) {
+	return (uint)key;			// το Fibonacci hashing σκορπίζει ήδη τα διαδοχικά keys
+}
+
+static inline bool typed_map_equal_int(int a, int b) {
+	return a == b;
+}
+
+static inline uint typed_map_hash_string(const char* key) {
+	// FNV-1a, απλή και εύκολη να γίνει inline
+	uint hash = 2166136261u;
+	for (const char* s = key; *s != '\0'; s++)
+		hash = (hash ^ (unsigned char)*s) * 16777619u;
+	return hash;
+}
+
+static inline bool typed_map_equal_string(const char* a, const char* b) {
+	return strcmp(a, b) == 0;
+}
+
+
+// Παράγει τον τύπο Name (με κόμβους Name##Node) και τις συναρτήσεις:
+//
+//   Name*      Name##_create(void)
+//   void       Name##_destroy(Name* map)
+//   int        Name##_size(Name* map)
+//   void       Name##_insert(Name* map, KeyType key, ValueType value)	(αντικαθιστά το value αν το key υπάρχει)
+//   ValueType* Name##_find(Name* map, KeyType key)						(NULL αν το key δεν υπάρχει)
+//   bool       Name##_remove(Name* map, KeyType key)
+//   Name##Node* Name##_first(Name* map), Name##_next(Name* map, Name##Node* node)	(NULL στο τέλος)
+//
+// Τα keys/values αντιγράφονται στους κόμβους, οπότε για keys όπως char* η μνήμη τους ανήκει στον caller.
+// Ο pointer που επιστρέφει η find (και οι κόμβοι της διάσχισης) δεν είναι έγκυρος μετά από insert/remove/find,
+// γιατί το incremental rehash μπορεί να μετακινήσει τον κόμβο.
+
+#define DEFINE_MAP(Name, KeyType, ValueType, hash_fn, equal_fn)										\
+																									\
+typedef struct {																					\
+	KeyType key;																					\
+	ValueType value;																				\
+	uint hash;																						\
+	unsigned char state;																			\
+} Name##Node;																						\
+																									\
+typedef struct {																					\
+	Name##Node* array;																				\
+	int capacity;																					\
+	int shift;				/* 32 - log2(capacity), για το Fibonacci hashing */						\
+	int size;																						\
+	int deleted;																					\
+	Name##Node* old_array;	/* ο πίνακας από τον οποίο γίνεται incremental rehash, ή NULL */		\
+	int old_capacity;																				\
+	int old_shift;																					\
+	int rehash_index;		/* το επόμενο κελί του old_array που θα μεταφερθεί */					\
+} Name;																								\
+																									\
+static inline uint Name##_home_pos(uint hash, int shift) {											\
+	return (hash * TYPED_MAP_FIBONACCI_MULTIPLIER) >> shift;										\
+}																									\
+																									\
+static inline Name##Node* Name##_create_array(int capacity) {										\
+	Name##Node* array = malloc(capacity * sizeof(Name##Node));										\
+	for (int i = 0; i < capacity; i++)																\
+		array[i].state = TYPED_MAP_EMPTY;															\
+	return array;																					\
+}																									\
+																									\
+static inline Name* Name##_create(void) {															\
+	Name* map = malloc(sizeof(*map));																\
+	map->capacity = TYPED_MAP_INITIAL_CAPACITY;														\
+	map->shift = 32 - __builtin_ctz(map->capacity);													\
+	map->array = Name##_create_array(map->capacity);												\
+	map->size = 0;																					\
+	map->deleted = 0;																				\
+	map->old_array = NULL;																			\
+	map->old_capacity = 0;																			\
+	map->old_shift = 0;																				\
+	map->rehash_index = 0;																			\
+	return map;																						\
+}																									\
+																									\
+static inline void Name##_destroy(Name* map) {														\
+	free(map->old_array);																			\
+	free(map->array);																				\
+	free(map);																						\
+}																									\
+																									\
+static inline int Name##_size(Name* map) {															\
+	return map->size;																				\
+}																									\
+																									\
+static inline Name##Node* Name##_find_in(Name##Node* array, int capacity, int shift,				\
+		KeyType key, uint hash) {																	\
+	for (uint pos = Name##_home_pos(hash, shift); array[pos].state != TYPED_MAP_EMPTY;				\
+			pos = (pos + 1) & (capacity - 1)) {														\
+		if (array[pos].state == TYPED_MAP_OCCUPIED && array[pos].hash == hash						\
+				&& equal_fn(array[pos].key, key))													\
+			return &array[pos];																		\
+	}																								\
+	return NULL;																					\
+}																									\
+																									\
+/* Αναζήτηση στον τρέχοντα πίνακα και, κατά τη διάρκεια rehash, στον παλιό */						\
+static inline Name##Node* Name##_find_node(Name* map, KeyType key, uint hash) {					\
+	Name##Node* node = Name##_find_in(map->array, map->capacity, map->shift, key, hash);			\
+	if (node == NULL && map->old_array != NULL)														\
+		node = Name##_find_in(map->old_array, map->old_capacity, map->old_shift, key, hash);		\
+	return node;																					\
+}																									\
+																									\
+/* Τοποθετεί κόμβο του οποίου το key σίγουρα δεν υπάρχει, με το αποθηκευμένο hash code */			\
+static inline void Name##_place_node(Name* map, Name##Node* node) {								\
+	uint pos = Name##_home_pos(node->hash, map->shift);												\
+	while (map->array[pos].state == TYPED_MAP_OCCUPIED)												\
+		pos = (pos + 1) & (map->capacity - 1);														\
+	if (map->array[pos].state == TYPED_MAP_DELETED)													\
+		map->deleted--;																				\
+	map->array[pos] = *node;																		\
+}																									\
+																									\
+static inline void Name##_rehash_step(Name* map, int steps) {										\
+	if (map->old_array == NULL)																		\
+		return;																						\
+	for (int i = 0; i < steps && map->rehash_index < map->old_capacity; i++, map->rehash_index++) {	\
+		Name##Node* old_node = &map->old_array[map->rehash_index];									\
+		if (old_node->state == TYPED_MAP_OCCUPIED) {												\
+			Name##_place_node(map, old_node);														\
+			old_node->state = TYPED_MAP_DELETED;	/* ώστε να μη σπάσουν οι αλυσίδες του παλιού */	\
+		}																							\
+	}																								\
+	if (map->rehash_index == map->old_capacity) {													\
+		free(map->old_array);																		\
+		map->old_array = NULL;																		\
+		map->old_capacity = 0;																		\
+		map->rehash_index = 0;																		\
+	}																								\
+}																									\
+																									\
+static inline void Name##_start_rehash(Name* map, int new_capacity) {								\
+	Name##_rehash_step(map, map->old_capacity);		/* ολοκλήρωση του προηγούμενου rehash */		\
+	map->old_array = map->array;																	\
+	map->old_capacity = map->capacity;																\
+	map->old_shift = map->shift;																	\
+	map->rehash_index = 0;																			\
+	map->capacity = new_capacity;																	\
+	map->shift = 32 - __builtin_ctz(new_capacity);													\
+	map->array = Name##_create_array(new_capacity);													\
+	map->deleted = 0;																				\
+}																									\
+																									\
+static inline void Name##_insert(Name* map, KeyType key, ValueType value) {						\
+	uint hash = hash_fn(key);																		\
+																									\
+	/* Αν είμαστε στη μέση ενός rehash, το key μπορεί να βρίσκεται ακόμα στον παλιό πίνακα */		\
+	Name##Node* node = NULL;																		\
+	if (map->old_array != NULL)																		\
+		node = Name##_find_in(map->old_array, map->old_capacity, map->old_shift, key, hash);		\
+																									\
+	if (node == NULL) {																				\
+		Name##Node* deleted = NULL;																	\
+		uint pos;																					\
+		for (pos = Name##_home_pos(hash, map->shift); map->array[pos].state != TYPED_MAP_EMPTY;		\
+				pos = (pos + 1) & (map->capacity - 1)) {											\
+			if (map->array[pos].state == TYPED_MAP_DELETED) {										\
+				if (deleted == NULL)																\
+					deleted = &map->array[pos];														\
+			} else if (map->array[pos].hash == hash && equal_fn(map->array[pos].key, key)) {		\
+				node = &map->array[pos];															\
+				break;																				\
+			}																						\
+		}																							\
+		if (node == NULL) {																			\
+			node = deleted != NULL ? deleted : &map->array[pos];									\
+			if (node->state == TYPED_MAP_DELETED)													\
+				map->deleted--;																		\
+			node->state = TYPED_MAP_OCCUPIED;														\
+			node->hash = hash;																		\
+			map->size++;																			\
+		}																							\
+	}																								\
+	node->key = key;																				\
+	node->value = value;																			\
+																									\
+	Name##_rehash_step(map, TYPED_MAP_REHASH_BUDGET);												\
+																									\
+	/* Στο load factor μετράμε και τα DELETED. Αν τα περισσότερα είναι DELETED, αρκεί rehash		\
+	   στο ίδιο μέγεθος, αλλιώς διπλασιάζουμε. */													\
+	if (map->size + map->deleted > map->capacity * TYPED_MAP_MAX_LOAD_FACTOR) {						\
+		bool grow = map->size > map->capacity * TYPED_MAP_MAX_LOAD_FACTOR / 2;						\
+		Name##_start_rehash(map, grow ? map->capacity * 2 : map->capacity);							\
+		Name##_rehash_step(map, TYPED_MAP_REHASH_BUDGET);											\
+	}																								\
+}																									\
+																									\
+static inline ValueType* Name##_find(Name* map, KeyType key) {										\
+	Name##_rehash_step(map, TYPED_MAP_REHASH_BUDGET);	/* πριν την αναζήτηση, ώστε ο κόμβος να μη μετακινηθεί */	\
+	Name##Node* node = Name##_find_node(map, key, hash_fn(key));									\
+	return node != NULL ? &node->value : NULL;														\
+}																									\
+																									\
+static inline bool Name##_remove(Name* map, KeyType key) {											\
+	Name##Node* node = Name##_find_node(map, key, hash_fn(key));									\
+	if (node == NULL)																				\
+		return false;																				\
+																									\
+	node->state = TYPED_MAP_DELETED;																\
+	if (node >= map->array && node < map->array + map->capacity)									\
+		map->deleted++;																				\
+	map->size--;																					\
+																									\
+	Name##_rehash_step(map, TYPED_MAP_REHASH_BUDGET);												\
+	return true;																					\
+}																									\
+																									\
+/* Διάσχιση: πρώτα ο τρέχων πίνακας, μετά (κατά τη διάρκεια rehash) ο παλιός */						\
+static inline Name##Node* Name##_next_from(Name* map, Name##Node* node) {							\
+	if (node >= map->array && node <= map->array + map->capacity) {									\
+		for (; node < map->array + map->capacity; node++)											\
+			if (node->state == TYPED_MAP_OCCUPIED)													\
+				return node;																		\
+		if (map->old_array == NULL)																	\
+			return NULL;																			\
+		node = map->old_array;																		\
+	}																								\
+	for (; node < map->old_array + map->old_capacity; node++)										\
+		if (node->state == TYPED_MAP_OCCUPIED)														\
+			return node;																			\
+	return NULL;																					\
+}																									\
+																									\
+static inline Name##Node* Name##_first(Name* map) {												\
+	return Name##_next_from(map, map->array);														\
+}																									\
+																									\
+static inline Name##Node* Name##_next(Name* map, Name##Node* node) {								\
+	return Name##_next_from(map, node + 1);															\
+}
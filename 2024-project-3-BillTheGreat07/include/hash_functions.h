@@ -0,0 +1,26 @@
+///////////////////////////////////////////////////////////
+//
+// Συναρτήσεις κατακερματισμού
+//
+// Κοινή υλοποίηση των hash_string, hash_int και hash_pointer (που δηλώνονται στο ADTMap.h) για όλες
+// τις υλοποιήσεις του ADTMap, μαζί με τις εκδοχές τους που δέχονται seed.
+//
+///////////////////////////////////////////////////////////
+
+#pragma once // #include το πολύ μία φορά
+
+#include "common_types.h"
+
+#include <stdint.h>
+
+
+// Συνάρτηση κατακερματισμού που δέχεται και ένα seed
+
+typedef uint (*SeededHashFunc)(Pointer, uint64_t);
+
+// Οι hash_string, hash_int και hash_pointer με συγκεκριμένο seed. Οι εκδοχές χωρίς seed είναι
+// αυτές με seed 0.
+
+uint hash_string_seeded(Pointer value, uint64_t seed);
+uint hash_int_seeded(Pointer value, uint64_t seed);
+uint hash_pointer_seeded(Pointer value, uint64_t seed);
@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση των συναρτήσεων κατακερματισμού, κοινή για όλες τις υλοποιήσεις του ADTMap
+//
+// Ολες βασίζονται στον πολλαπλασιασμό 64x64 -> 128 bit (όπως το wyhash): το γινόμενο με μια τυχαία
+// σταθερά, με XOR του πάνω και του κάτω μισού, ανακατεύει καλά όλα τα bits με μία εντολή.
+// Το hash code είναι τα κάτω 32 bits.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "ADTMap.h"
+#include "hash_functions.h"
+
+
+#define HASH_P0 0xa0761d6478bd642full
+#define HASH_P1 0xe7037ed1a0b428dbull
+#define HASH_P2 0x8ebc6af09c88c6e3ull
+
+static inline uint64_t mum(uint64_t a, uint64_t b) {
+	__uint128_t product = (__uint128_t)a * b;
+	return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+static inline uint64_t read64(const char* p) {
+	uint64_t word;
+	memcpy(&word, p, sizeof(word));			// ο compiler το κάνει ένα load, χωρίς απαίτηση για alignment
+	return word;
+}
+
+// Hash των len bytes του data, 16 bytes τη φορά
+
+static uint64_t hash_bytes(const char* data, size_t len, uint64_t seed) {
+	uint64_t state = seed ^ HASH_P0;
+	size_t remaining = len;
+
+	for (; remaining > 16; remaining -= 16, data += 16)
+		state = mum(read64(data) ^ HASH_P1, read64(data + 8) ^ state);
+
+	// Τα τελευταία (0 έως 16) bytes. Αν είναι πάνω από 8, διαβάζουμε δύο λέξεις που επικαλύπτονται,
+	// αλλιώς μία λέξη συμπληρωμένη με μηδενικά.
+	uint64_t a = 0, b = 0;
+	if (remaining > 8) {
+		a = read64(data);
+		b = read64(data + remaining - 8);
+	} else {
+		memcpy(&a, data, remaining);
+	}
+
+	return mum(HASH_P1 ^ len, mum(a ^ HASH_P2, b ^ state));
+}
+
+uint hash_string_seeded(Pointer value, uint64_t seed) {
+	return hash_bytes(value, strlen(value), seed);
+}
+
+uint hash_int_seeded(Pointer value, uint64_t seed) {
+	return mum((uint)*(int*)value ^ seed ^ HASH_P0, HASH_P1);
+}
+
+uint hash_pointer_seeded(Pointer value, uint64_t seed) {
+	// Χρησιμοποιούνται όλα τα 64 bits του pointer (όχι μόνο τα κάτω 32), και τα μηδενικά bits
+	// του alignment δεν προκαλούν συγκρούσεις, γιατί ο πολλαπλασιασμός τα ανακατεύει με τα υπόλοιπα.
+	return mum((uintptr_t)value ^ seed ^ HASH_P0, HASH_P1);
+}
+
+uint hash_string(Pointer value) {
+	return hash_string_seeded(value, 0);
+}
+
+uint hash_int(Pointer value) {
+	return hash_int_seeded(value, 0);
+}
+
+uint hash_pointer(Pointer value) {
+	return hash_pointer_seeded(value, 0);
+}
@@ -0,0 +1,294 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Hash Table με συμπαγή αποθήκευση (όπως το dict της Python)
+//
+// Τα στοιχεία αποθηκεύονται με τη σειρά εισαγωγής σε έναν πυκνό πίνακα entries. Το hash table
+// (indices) περιέχει μόνο τη θέση κάθε στοιχείου στον entries, σε 1, 2 ή 4 bytes ανάλογα με το
+// μέγεθος του map, με linear probing. Ετσι:
+// - η διάσχιση είναι O(size), σε συνεχόμενη μνήμη, και με τη σειρά εισαγωγής (ίδια και μετά από rehash)
+// - ο πίνακας entries έχει μόνο όσες θέσεις επιτρέπει το load factor, οπότε με load factor 0.5
+//   ένα στοιχείο κοστίζει 24 bytes + 2 θέσεις του indices, αντί για 2 κόμβους των 24 bytes
+//
+// Η διαγραφή μαρκάρει το στοιχείο ως deleted, και τη θέση του στο indices ως DUMMY. Οταν τα
+// deleted γίνουν περισσότερα από τα μισά, ο entries συμπιέζεται (κρατώντας τη σειρά), οπότε
+// μετά από map_remove οι MapNode που έχουμε κρατήσει μπορεί να μην είναι έγκυροι.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ADTMap.h"
+
+
+// Το μέγεθος του indices είναι δύναμη του 2, και η θέση κάθε key υπολογίζεται με Fibonacci hashing
+#define INITIAL_CAPACITY 8
+#define FIBONACCI_MULTIPLIER 2654435769u
+
+// Ο entries έχει capacity * MAX_LOAD_FACTOR θέσεις. Κάθε στοιχείο (και κάθε deleted, μέχρι τη
+// συμπίεση) έχει ακριβώς μία θέση στο indices, οπότε ο load factor του indices δεν το ξεπερνάει ποτέ.
+#define MAX_LOAD_FACTOR 0.5
+
+// Τιμές του indices που δεν αντιστοιχούν σε στοιχείο
+#define EMPTY -1			// Κενή θέση, η αναζήτηση σταματάει
+#define DUMMY -2			// Θέση στοιχείου που διαγράφηκε, η αναζήτηση συνεχίζει
+
+// Δομή του κάθε στοιχείου (του πίνακα entries)
+struct map_node {
+	Pointer key;
+	Pointer value;
+	uint hash;			// Το hash code του key, ώστε να μην το ξαναυπολογίζουμε στο rehash
+	bool deleted;		// Αν το στοιχείο έχει διαγραφεί (η θέση του μένει κενή μέχρι τη συμπίεση)
+};
+
+// Δομή του Map
+struct map {
+	void* indices;				// Το hash table: θέσεις του entries (ή EMPTY/DUMMY), με στοιχεία των index_width bytes
+	int index_width;			// 1, 2 ή 4, το μικρότερο που χωράει κάθε θέση του entries
+	int capacity;				// Μέγεθος του indices (δύναμη του 2)
+	int shift;					// 32 - log2(capacity), για τον υπολογισμό της αρχικής θέσης
+	MapNode entries;			// Τα στοιχεία, με τη σειρά εισαγωγής
+	int entries_capacity;		// Μέγεθος του entries
+	int used;					// Πόσες θέσεις του entries έχουν χρησιμοποιηθεί (μαζί με τα deleted)
+	int size;					// Πόσα στοιχεία έχουμε προσθέσει
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+// Η θέση στην οποία κάνει hash ένα hash code
+static inline uint home_pos(Map map, uint hash) {
+	return (hash * FIBONACCI_MULTIPLIER) >> map->shift;
+}
+
+// Η επόμενη θέση, γυρνώντας στην αρχή όταν φτάσουμε στο τέλος του πίνακα
+static inline uint next_pos(Map map, uint pos) {
+	return (pos + 1) & (map->capacity - 1);
+}
+
+// Η τιμή του indices στη θέση pos
+static inline int get_index(Map map, uint pos) {
+	switch (map->index_width) {
+		case 1:  return ((int8_t*)map->indices)[pos];
+		case 2:  return ((int16_t*)map->indices)[pos];
+		default: return ((int32_t*)map->indices)[pos];
+	}
+}
+
+static inline void set_index(Map map, uint pos, int index) {
+	switch (map->index_width) {
+		case 1:  ((int8_t*)map->indices)[pos] = index; break;
+		case 2:  ((int16_t*)map->indices)[pos] = index; break;
+		default: ((int32_t*)map->indices)[pos] = index; break;
+	}
+}
+
+// Το μικρότερο μέγεθος indices (τουλάχιστον INITIAL_CAPACITY) στο οποίο χωράνε entries στοιχεία με load factor load
+static int capacity_for(int entries, double load) {
+	int capacity = INITIAL_CAPACITY;
+	while (entries > capacity * load)
+		capacity *= 2;
+	return capacity;
+}
+
+// Δεσμεύει κενούς πίνακες indices (μεγέθους capacity) και entries
+static void allocate_arrays(Map map, int capacity) {
+	map->capacity = capacity;
+	map->shift = 32 - __builtin_ctz(capacity);
+	map->entries_capacity = capacity * MAX_LOAD_FACTOR;
+	map->used = 0;
+
+	// Αρκεί το μικρότερο πλάτος στο οποίο χωράει η μεγαλύτερη θέση του entries
+	map->index_width =
+		map->entries_capacity <= INT8_MAX ? 1 :
+		map->entries_capacity <= INT16_MAX ? 2 :
+		4;
+
+	// Τα bytes 0xFF δίνουν -1 = EMPTY, για οποιοδήποτε πλάτος
+	map->indices = malloc(capacity * map->index_width);
+	memset(map->indices, 0xFF, capacity * map->index_width);
+	map->entries = malloc(map->entries_capacity * sizeof(struct map_node));
+}
+
+// Προσθέτει το στοιχείο entry (που σίγουρα δεν υπάρχει στο map) στο τέλος του entries.
+// Επιστρέφει τον κόμβο στον οποίο αποθηκεύτηκε.
+static MapNode append_entry(Map map, struct map_node entry) {
+	uint pos = home_pos(map, entry.hash);
+	for (int index = get_index(map, pos); index != EMPTY && index != DUMMY; index = get_index(map, pos))
+		pos = next_pos(map, pos);
+
+	set_index(map, pos, map->used);
+	map->entries[map->used] = entry;
+	return &map->entries[map->used++];
+}
+
+// Φτιάχνει νέους πίνακες με indices μεγέθους new_capacity, μεταφέροντας τα στοιχεία (χωρίς τα deleted)
+// με τη σειρά εισαγωγής, και χρησιμοποιώντας τα αποθηκευμένα hash codes
+static void resize(Map map, int new_capacity) {
+	MapNode old_entries = map->entries;
+	int old_used = map->used;
+
+	free(map->indices);
+	allocate_arrays(map, new_capacity);
+	for (int i = 0; i < old_used; i++)
+		if (!old_entries[i].deleted)
+			append_entry(map, old_entries[i]);
+
+	free(old_entries);
+}
+
+// Αναζητά τη θέση του indices που αντιστοιχεί στο key (του οποίου το hash code είναι hash), ή -1 αν δεν υπάρχει
+
+static int find_pos(Map map, Pointer key, uint hash) {
+	uint pos = home_pos(map, hash);
+	for (int index = get_index(map, pos); index != EMPTY; pos = next_pos(map, pos), index = get_index(map, pos)) {
+		if (index == DUMMY)
+			continue;
+
+		MapNode entry = &map->entries[index];
+		if (entry->hash == hash && map->compare(entry->key, key) == 0)
+			return pos;
+	}
+	return -1;
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+	allocate_arrays(map, INITIAL_CAPACITY);
+
+	map->size = 0;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint hash = map->hash_function(key);
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value (το στοιχείο κρατάει τη θέση του στη σειρά)
+	int pos = find_pos(map, key, hash);
+	if (pos != -1) {
+		MapNode node = &map->entries[get_index(map, pos)];
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	// Αν ο entries γέμισε, rehash σε indices στο οποίο τα στοιχεία πιάνουν το μισό του επιτρεπτού
+	// (αν τα περισσότερα ήταν deleted, το μέγεθος μπορεί να μείνει ίδιο, απλά συμπιέζεται ο entries)
+	if (map->used == map->entries_capacity)
+		resize(map, capacity_for(map->size + 1, MAX_LOAD_FACTOR / 2));
+
+	struct map_node entry = { .key = key, .value = value, .hash = hash, .deleted = false };
+	append_entry(map, entry);
+	map->size++;
+}
+
+bool map_remove(Map map, Pointer key) {
+	int pos = find_pos(map, key, map->hash_function(key));
+	if (pos == -1)
+		return false;
+
+	MapNode node = &map->entries[get_index(map, pos)];
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	node->deleted = true;
+	set_index(map, pos, DUMMY);
+	map->size--;
+
+	// Αν τα deleted είναι πάνω από τα μισά, συμπιέζουμε τον entries (ώστε η διάσχιση να μένει O(size)),
+	// μικραίνοντας και τους πίνακες αν τα στοιχεία χωράνε σε μικρότερους
+	if (map->size < map->used / 2)
+		resize(map, capacity_for(map->size, MAX_LOAD_FACTOR / 2));
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	for (int i = 0; i < map->used; i++) {
+		if (!map->entries[i].deleted) {
+			if (map->destroy_key != NULL)
+				map->destroy_key(map->entries[i].key);
+			if (map->destroy_value != NULL)
+				map->destroy_value(map->entries[i].value);
+		}
+	}
+
+	free(map->indices);
+	free(map->entries);
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+//
+// Η διάσχιση γίνεται με τη σειρά εισαγωγής (η αντικατάσταση ενός key δεν αλλάζει τη θέση του)
+
+MapNode map_first(Map map) {
+	for (int i = 0; i < map->used; i++)
+		if (!map->entries[i].deleted)
+			return &map->entries[i];
+
+	return MAP_EOF;
+}
+
+MapNode map_next(Map map, MapNode node) {
+	for (int i = node - map->entries + 1; i < map->used; i++)
+		if (!map->entries[i].deleted)
+			return &map->entries[i];
+
+	return MAP_EOF;
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	int pos = find_pos(map, key, map->hash_function(key));
+	return pos != -1 ? &map->entries[get_index(map, pos)] : MAP_EOF;
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
@@ -0,0 +1,412 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Cuckoo hashing με buckets
+//
+// Ο πίνακας χωρίζεται σε buckets των BUCKET_SIZE κόμβων, που μαζί με τα hash codes των κόμβων
+// καταλαμβάνουν ακριβώς ένα cache line. Κάθε key μπορεί να βρίσκεται μόνο σε δύο buckets, που
+// υπολογίζονται από το hash code με δύο διαφορετικούς τρόπους, ή στο μικρό stash του map. Οπότε η
+// αναζήτηση εξετάζει το πολύ δύο cache lines του πίνακα (και το stash, μόνο όταν δεν είναι άδειο),
+// ανεξάρτητα από το load factor.
+//
+// Αν και τα δύο buckets ενός νέου key είναι γεμάτα, το key "διώχνει" έναν κόμβο, ο οποίος
+// μεταφέρεται στο άλλο bucket του, διώχνοντας πιθανώς κάποιον άλλο, κοκ. Αν μετά από
+// MAX_EVICTIONS μετακινήσεις δεν έχει βρεθεί ελεύθερη θέση, ο κόμβος που περισσεύει μπαίνει
+// στο stash, και αν γεμίσει και αυτό, διπλασιάζουμε τον πίνακα. Αν όμως ο πίνακας είναι ακόμα
+// αραιός (πολλά keys με το ίδιο hash code, οπότε ο διπλασιασμός δε θα βοηθούσε), μεγαλώνει το stash.
+//
+// Λόγω των μετακινήσεων, μετά από map_insert οι MapNode που έχουμε κρατήσει δεν είναι έγκυροι.
+// Επίσης η hash_function πρέπει να δίνει αρκετά διαφορετικά hash codes: keys με το ίδιο hash code έχουν
+// τα ίδια δύο buckets, και όσα δε χωράνε σε αυτά καταλήγουν στο stash, που διατρέχεται σειριακά.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ADTMap.h"
+
+
+// 3 κόμβοι των 16 bytes και τα 3 hash codes τους, δηλαδή ένα cache line των 64 bytes
+#define BUCKET_SIZE 3
+
+// Το πλήθος των buckets είναι πάντα δύναμη του 2
+#define INITIAL_BUCKETS 16
+
+// Με 3 θέσεις σε καθένα από τα 2 buckets κάθε key, ο πίνακας γεμίζει μέχρι περίπου 95% πριν αρχίσουν
+// να αποτυγχάνουν οι εισαγωγές, οπότε το 90% αφήνει αρκετό περιθώριο ώστε οι μετακινήσεις να είναι λίγες.
+#define MAX_LOAD_FACTOR 0.9
+
+// Μέγιστο μήκος μιας αλυσίδας μετακινήσεων κατά την εισαγωγή
+#define MAX_EVICTIONS 256
+
+// Πόσοι κόμβοι χωράνε αρχικά στο stash
+#define STASH_SIZE 8
+
+// Αν ο πίνακας είναι γεμάτος λιγότερο από αυτό, μεγαλώνουμε το stash αντί για τον πίνακα
+#define MIN_RESIZE_LOAD_FACTOR 0.45
+
+// Σταθερά του Fibonacci hashing (2^64 / φ), για το πρώτο bucket
+#define FIBONACCI_MULTIPLIER 11400714819323198485ull
+
+// Όπως στο UsingHashTable, οι κενοί κόμβοι έχουν ως key τη διεύθυνση του empty_sentinel, που δεν μπορεί να
+// είναι key του χρήστη, ώστε ο κόμβος να είναι 16 bytes.
+static char empty_sentinel;
+#define EMPTY_KEY ((Pointer)&empty_sentinel)
+
+// Δομή του κάθε κόμβου
+struct map_node {
+	Pointer key;			// Το key (ή EMPTY_KEY)
+	Pointer value;
+};
+
+// Ενα bucket. Τα hash codes βρίσκονται στο ίδιο cache line με τους κόμβους, ώστε η αναζήτηση να τα εξετάζει
+// χωρίς επιπλέον πρόσβαση στη μνήμη, και το rehash να μη χρειάζεται την hash_function.
+typedef struct bucket* Bucket;
+
+struct bucket {
+	struct map_node nodes[BUCKET_SIZE];
+	uint hashes[BUCKET_SIZE];				// Το hash code κάθε μη κενού κόμβου (0 στους κενούς)
+	uint unused;							// Συμπλήρωση ώστε το bucket να είναι 64 bytes
+};
+
+_Static_assert(sizeof(struct bucket) == 64, "το bucket πρέπει να είναι ένα cache line");
+
+// Δομή του Map
+struct map {
+	Bucket array;							// Ο πίνακας των buckets (ευθυγραμμισμένος στα 64 bytes)
+	int buckets;							// Πλήθος των buckets (δύναμη του 2)
+	int shift;								// 64 - log2(buckets), για τον υπολογισμό των buckets ενός hash code
+	int size;								// Πόσα στοιχεία έχουμε προσθέσει (μαζί με αυτά του stash)
+	MapNode stash;							// Κόμβοι που δεν χώρεσαν σε κανένα από τα δύο buckets τους
+	uint* stash_hashes;						// Και τα hash codes τους
+	int stash_size;
+	int stash_capacity;
+	uint evictions;							// Μετρητής που επιλέγει (ψευδοτυχαία) ποιος κόμβος θα διωχτεί
+	CompareFunc compare;					// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;					// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;				// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+// Τα δύο buckets ενός hash code. Το δεύτερο προκύπτει από ανακάτεμα του hash code με τον finalizer του splitmix64,
+// οπότε είναι ανεξάρτητο από το πρώτο (δύο keys με το ίδιο πρώτο bucket σχεδόν πάντα έχουν διαφορετικό δεύτερο).
+
+static inline uint bucket1(Map map, uint hash) {
+	return ((uint64_t)hash * FIBONACCI_MULTIPLIER) >> map->shift;
+}
+
+static inline uint bucket2(Map map, uint hash) {
+	uint64_t x = hash + 0x9e3779b97f4a7c15ull;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return (x ^ (x >> 31)) >> map->shift;
+}
+
+static inline Bucket bucket_at(Map map, uint bucket) {
+	return &map->array[bucket];
+}
+
+// Το bucket του πίνακα στο οποίο ανήκει ο κόμβος node
+
+static inline Bucket bucket_of(Map map, MapNode node) {
+	return &map->array[((char*)node - (char*)map->array) / sizeof(struct bucket)];
+}
+
+// Δεσμεύει έναν κενό πίνακα με buckets buckets, και ένα κενό stash
+static void allocate_array(Map map, int buckets) {
+	map->buckets = buckets;
+	map->shift = 64 - __builtin_ctz(buckets);
+	map->array = aligned_alloc(64, buckets * sizeof(struct bucket));
+	for (int b = 0; b < buckets; b++) {
+		for (int i = 0; i < BUCKET_SIZE; i++) {
+			map->array[b].nodes[i].key = EMPTY_KEY;
+			map->array[b].hashes[i] = 0;
+		}
+		map->array[b].unused = 0;
+	}
+
+	map->stash = malloc(STASH_SIZE * sizeof(struct map_node));
+	map->stash_hashes = malloc(STASH_SIZE * sizeof(uint));
+	map->stash_size = 0;
+	map->stash_capacity = STASH_SIZE;
+}
+
+static inline bool in_stash(Map map, MapNode node) {
+	return node >= map->stash && node < map->stash + map->stash_capacity;
+}
+
+// Η θέση στην οποία αποθηκεύεται το hash code του κόμβου node (του πίνακα ή του stash)
+static inline uint* hash_of(Map map, MapNode node) {
+	if (in_stash(map, node))
+		return &map->stash_hashes[node - map->stash];
+
+	Bucket bucket = bucket_of(map, node);
+	return &bucket->hashes[node - bucket->nodes];
+}
+
+// Αναζητά το key (με hash code hash) στο bucket. Η compare καλείται μόνο σε μη κενούς κόμβους με ίδιο hash code.
+
+static inline MapNode find_in_bucket(Map map, uint bucket, Pointer key, uint hash) {
+	Bucket b = bucket_at(map, bucket);
+	for (int i = 0; i < BUCKET_SIZE; i++)
+		if (b->nodes[i].key != EMPTY_KEY && b->hashes[i] == hash && map->compare(b->nodes[i].key, key) == 0)
+			return &b->nodes[i];
+	return MAP_EOF;
+}
+
+static MapNode find_node(Map map, Pointer key, uint hash) {
+	MapNode node = find_in_bucket(map, bucket1(map, hash), key, hash);
+	if (node == MAP_EOF)
+		node = find_in_bucket(map, bucket2(map, hash), key, hash);
+
+	for (int i = 0; node == MAP_EOF && i < map->stash_size; i++)
+		if (map->stash_hashes[i] == hash && map->compare(map->stash[i].key, key) == 0)
+			node = &map->stash[i];
+
+	return node;
+}
+
+// Επιστρέφει έναν κενό κόμβο του bucket, ή NULL αν είναι γεμάτο
+
+static inline MapNode free_in_bucket(Map map, uint bucket) {
+	MapNode nodes = bucket_at(map, bucket)->nodes;
+	for (int i = 0; i < BUCKET_SIZE; i++)
+		if (nodes[i].key == EMPTY_KEY)
+			return &nodes[i];
+	return NULL;
+}
+
+// Τοποθετεί τον κόμβο *node (με hash code *hash), του οποίου το key σίγουρα δεν υπάρχει στο map, σε ένα από τα
+// δύο buckets του, μετακινώντας αν χρειαστεί άλλους κόμβους. Αν ο κόμβος που περισσεύει στο τέλος δε χωράει
+// ούτε στο stash, επιστρέφει false και τον αφήνει στα *node, *hash (δεν είναι απαραίτητα ο αρχικός).
+
+static bool place_node(Map map, MapNode node, uint* hash) {
+	uint bucket = bucket1(map, *hash);
+	MapNode free_node = free_in_bucket(map, bucket);
+	if (free_node == NULL) {
+		bucket = bucket2(map, *hash);
+		free_node = free_in_bucket(map, bucket);
+	}
+
+	// Και τα δύο buckets είναι γεμάτα. Διώχνουμε έναν (ψευδοτυχαίο) κόμβο του bucket, και τον μεταφέρουμε στο
+	// άλλο bucket του. Αν είναι και αυτό γεμάτο, διώχνουμε κάποιον κόμβο από εκεί, κοκ.
+	for (int i = 0; free_node == NULL && i < MAX_EVICTIONS; i++) {
+		MapNode victim = &bucket_at(map, bucket)->nodes[map->evictions++ % BUCKET_SIZE];
+		struct map_node evicted = *victim;
+		uint evicted_hash = *hash_of(map, victim);
+		*victim = *node;
+		*hash_of(map, victim) = *hash;
+		*node = evicted;
+		*hash = evicted_hash;
+
+		uint first = bucket1(map, evicted_hash);
+		bucket = first != bucket ? first : bucket2(map, evicted_hash);
+		free_node = free_in_bucket(map, bucket);
+	}
+
+	if (free_node != NULL) {
+		*free_node = *node;
+		*hash_of(map, free_node) = *hash;
+		return true;
+	}
+	if (map->stash_size == map->stash_capacity && map->size < map->buckets * BUCKET_SIZE * MIN_RESIZE_LOAD_FACTOR) {
+		map->stash_capacity *= 2;
+		map->stash = realloc(map->stash, map->stash_capacity * sizeof(struct map_node));
+		map->stash_hashes = realloc(map->stash_hashes, map->stash_capacity * sizeof(uint));
+	}
+	if (map->stash_size < map->stash_capacity) {
+		map->stash_hashes[map->stash_size] = *hash;
+		map->stash[map->stash_size++] = *node;
+		return true;
+	}
+	return false;
+}
+
+// Αλλάζει το πλήθος των buckets σε new_buckets, μεταφέροντας όλους τους κόμβους (και αυτούς του stash) με τα
+// αποθηκευμένα hash codes τους. Οι κόμβοι αντιγράφονται από τον παλιό πίνακα, οπότε αν κάποιος δε χωράει (πολύ
+// σπάνιο), απλά ξαναδοκιμάζουμε με διπλάσιο πίνακα.
+
+static void resize(Map map, int new_buckets) {
+	Bucket old_array = map->array;
+	int old_buckets = map->buckets;
+	MapNode old_stash = map->stash;
+	uint* old_stash_hashes = map->stash_hashes;
+	int old_stash_size = map->stash_size;
+
+	for (bool placed = false; !placed; new_buckets *= 2) {
+		allocate_array(map, new_buckets);
+
+		placed = true;
+		for (int b = 0; placed && b < old_buckets; b++) {
+			for (int i = 0; placed && i < BUCKET_SIZE; i++) {
+				if (old_array[b].nodes[i].key != EMPTY_KEY) {
+					struct map_node node = old_array[b].nodes[i];
+					uint hash = old_array[b].hashes[i];
+					placed = place_node(map, &node, &hash);
+				}
+			}
+		}
+		for (int i = 0; placed && i < old_stash_size; i++) {
+			struct map_node node = old_stash[i];
+			uint hash = old_stash_hashes[i];
+			placed = place_node(map, &node, &hash);
+		}
+
+		if (!placed) {
+			free(map->array);
+			free(map->stash);
+			free(map->stash_hashes);
+		}
+	}
+
+	free(old_array);
+	free(old_stash);
+	free(old_stash_hashes);
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+	allocate_array(map, INITIAL_BUCKETS);
+
+	map->size = 0;
+	map->evictions = 0;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint hash = map->hash_function(key);
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value
+	MapNode node = find_node(map, key, hash);
+	if (node != MAP_EOF) {
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	if (map->size + 1 > map->buckets * BUCKET_SIZE * MAX_LOAD_FACTOR)
+		resize(map, map->buckets * 2);
+
+	// Αν ο κόμβος που περίσσεψε δε χωράει ούτε στο stash, διπλασιάζουμε τον πίνακα και τον ξανατοποθετούμε
+	struct map_node new_node = { .key = key, .value = value };
+	while (!place_node(map, &new_node, &hash))
+		resize(map, map->buckets * 2);
+	map->size++;
+}
+
+bool map_remove(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	if (node == MAP_EOF)
+		return false;
+
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	// Στο cuckoo hashing δε χρειάζονται DELETED κόμβοι: κάθε key αναζητείται μόνο στα δύο buckets του,
+	// οπότε ο κόμβος απλά αδειάζει. Από το stash αφαιρείται μετακινώντας τον τελευταίο κόμβο στη θέση του.
+	if (in_stash(map, node)) {
+		map->stash_size--;
+		*node = map->stash[map->stash_size];
+		*hash_of(map, node) = map->stash_hashes[map->stash_size];
+	} else {
+		node->key = EMPTY_KEY;
+		*hash_of(map, node) = 0;
+	}
+	map->size--;
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		if (map->destroy_key != NULL)
+			map->destroy_key(node->key);
+		if (map->destroy_value != NULL)
+			map->destroy_value(node->value);
+	}
+
+	free(map->array);
+	free(map->stash);
+	free(map->stash_hashes);
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+
+// Πρώτα οι κόμβοι του πίνακα, και μετά αυτοί του stash
+
+// Ο πρώτος μη κενός κόμβος του πίνακα από τη θέση i του bucket b και μετά, ή του stash αν δεν υπάρχει
+
+static MapNode next_from(Map map, int b, int i) {
+	for (; b < map->buckets; b++, i = 0)
+		for (; i < BUCKET_SIZE; i++)
+			if (map->array[b].nodes[i].key != EMPTY_KEY)
+				return &map->array[b].nodes[i];
+
+	return map->stash_size > 0 ? &map->stash[0] : MAP_EOF;
+}
+
+MapNode map_first(Map map) {
+	return next_from(map, 0, 0);
+}
+
+MapNode map_next(Map map, MapNode node) {
+	if (in_stash(map, node))
+		return node + 1 < map->stash + map->stash_size ? node + 1 : MAP_EOF;
+
+	Bucket bucket = bucket_of(map, node);
+	return next_from(map, bucket - map->array, node - bucket->nodes + 1);
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	return find_node(map, key, map->hash_function(key));
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
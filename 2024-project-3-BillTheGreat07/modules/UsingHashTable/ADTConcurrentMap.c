@@ -0,0 +1,389 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT ConcurrentMap μέσω Hash Table με open addressing (linear probing)
+//
+// Τα keys μοιράζονται, με βάση τα υψηλά bits του hash code, σε STRIPES ανεξάρτητα τμήματα (stripes).
+// Κάθε stripe είναι ένα hash table όπως αυτό του UsingHashTable/ADTMap.c (linear probing, DELETED
+// κόμβοι, incremental rehash), με δικό του lock για τους writers και δικό του sequence counter (seqlock):
+//
+// - Κάθε τροποποίηση παίρνει το lock του stripe, και αυξάνει το sequence πριν και μετά τις αλλαγές,
+//   οπότε όσο γίνεται η τροποποίηση το sequence είναι περιττός αριθμός.
+// - Η αναζήτηση δεν παίρνει lock: διαβάζει το sequence, κάνει την αναζήτηση, και την επαναλαμβάνει
+//   αν στο μεταξύ το sequence άλλαξε (ή ήταν περιττό), δηλαδή αν διάβασε ενδεχομένως μισοτελειωμένες αλλαγές.
+//
+// Το rehash κάθε stripe γίνεται ανεξάρτητα από τα υπόλοιπα και σταδιακά: κάθε writer του stripe
+// (οποιοδήποτε thread) μεταφέρει REHASH_BUDGET κελιά του παλιού πίνακα στον νέο, οπότε η δουλειά
+// μοιράζεται σε όλα τα threads που γράφουν, και κανένα thread δε σταματάει για ολόκληρο rehash.
+// Οι αναζητήσεις εξετάζουν και τους δύο πίνακες.
+//
+// Ένα thread που κάνει αναζήτηση μπορεί ακόμα να διαβάζει έναν πίνακα μετά το τέλος του rehash, οπότε
+// οι παλιοί πίνακες δεν αποδεσμεύονται πριν το concurrent_map_destroy, αλλά ξαναχρησιμοποιούνται από
+// επόμενα rehash του stripe με το ίδιο μέγεθος (πχ όταν ο πίνακας καθαρίζει από DELETED κελιά). Μια
+// αναζήτηση που διαβάζει πίνακα ο οποίος στο μεταξύ ξαναχρησιμοποιήθηκε διαβάζει έγκυρη μνήμη, και
+// απλά επαναλαμβάνεται, αφού το sequence έχει αλλάξει. Έτσι κάθε stripe έχει το πολύ δύο πίνακες κάθε
+// μεγέθους, και (αφού κάθε μέγεθος είναι διπλάσιο του προηγούμενου) οι πίνακες που δε χρησιμοποιούνται
+// καταλαμβάνουν λιγότερο από το τριπλάσιο του τρέχοντος. Για τον ίδιο λόγο ο πίνακας δε μικραίνει ποτέ.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "ADTConcurrentMap.h"
+
+
+// Πλήθος των stripes (δύναμη του 2). Αρκετά περισσότερα από τα threads, ώστε δύο writers σπάνια να
+// χρειάζονται το ίδιο lock.
+#define STRIPE_BITS 6
+#define STRIPES (1 << STRIPE_BITS)
+
+// Αρχικό μέγεθος του πίνακα κάθε stripe (δύναμη του 2)
+#define INITIAL_CAPACITY 16
+
+// Όπως στο UsingHashTable, ο load factor (μαζί με τους DELETED κόμβους) παραμένει <= 0.5
+#define MAX_LOAD_FACTOR 0.5
+
+// Πόσα κελιά του παλιού πίνακα μεταφέρει κάθε τροποποίηση κατά το incremental rehash
+#define REHASH_BUDGET 4
+
+// Τιμές του key για κενά κελιά και κελιά που διαγράφηκαν: οι διευθύνσεις των δύο bytes του sentinels, που
+// δεν μπορεί να είναι keys του χρήστη (οπότε επιτρέπονται οποιαδήποτε keys, και NULL ή μικροί ακέραιοι)
+static char sentinels[2];
+#define EMPTY_KEY ((uintptr_t)&sentinels[0])
+#define DELETED_KEY ((uintptr_t)&sentinels[1])
+
+// Ένα κελί του πίνακα. Τα πεδία διαβάζονται από αναζητήσεις ταυτόχρονα με τις τροποποιήσεις,
+// οπότε είναι atomic (με relaxed προσπελάσεις, η σειρά εξασφαλίζεται από το sequence).
+struct slot {
+	_Atomic uintptr_t key;		// Το key, ή EMPTY_KEY / DELETED_KEY
+	_Atomic(Pointer) value;
+	_Atomic uint hash;			// Το hash code του key, ώστε να μην το ξαναυπολογίζουμε στο rehash
+};
+
+// Ένας πίνακας. Το μέγεθος αποθηκεύεται μαζί με τα κελιά, ώστε μια αναζήτηση να βλέπει πάντα
+// μέγεθος και κελιά του ίδιου πίνακα (ακόμα και αν στο μεταξύ ξεκίνησε rehash).
+typedef struct table* Table;
+
+struct table {
+	int capacity;				// Πλήθος κελιών (δύναμη του 2)
+	Table retired_next;			// Ο επόμενος στη λίστα πινάκων που δεν χρησιμοποιούνται πλέον
+	struct slot slots[];
+};
+
+// Ένα stripe, σε δικό του cache line ώστε τα locks/sequences διαφορετικών stripes να μην επηρεάζουν το ένα το άλλο
+struct stripe {
+	_Alignas(64) _Atomic uint sequence;		// Περιττό όσο γίνεται τροποποίηση
+	pthread_mutex_t lock;					// Για τους writers του stripe
+	_Atomic(Table) table;					// Ο τρέχων πίνακας
+	_Atomic(Table) old_table;				// Ο πίνακας που μεταφέρεται στον table (NULL αν δεν γίνεται rehash)
+	int rehash_index;						// Το επόμενο κελί του old_table που θα μεταφερθεί
+	int used;								// Κελιά του table που δεν είναι EMPTY (στοιχεία + DELETED)
+	_Atomic int size;						// Πόσα στοιχεία έχει το stripe
+	Table retired;							// Πίνακες που δεν χρησιμοποιούνται πλέον, για επόμενα rehash
+};
+
+// Δομή του ConcurrentMap
+struct concurrent_map {
+	struct stripe stripes[STRIPES];
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+};
+
+typedef struct stripe* Stripe;
+typedef struct slot* Slot;
+
+
+// Αν ένα κελί με αυτό το key περιέχει στοιχείο (το key δεν είναι κανένα από τα δύο διαδοχικά sentinels)
+static inline bool is_occupied(uintptr_t key) {
+	return key - EMPTY_KEY > 1;
+}
+
+
+// Τα υψηλά bits του hash code επιλέγουν stripe και τα χαμηλά τη θέση, οπότε ανακατεύουμε πρώτα τα bits του
+// (finalizer του MurmurHash3), ώστε πχ το hash_int μικρών αριθμών να μην καταλήγει όλο στο πρώτο stripe.
+static inline uint mix_hash(uint hash) {
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+static inline Stripe stripe_of(ConcurrentMap map, uint hash) {
+	return &map->stripes[hash >> (32 - STRIPE_BITS)];
+}
+
+static Table create_table(int capacity) {
+	Table table = malloc(sizeof(*table) + capacity * sizeof(struct slot));
+	table->capacity = capacity;
+	table->retired_next = NULL;
+	for (int i = 0; i < capacity; i++)
+		atomic_init(&table->slots[i].key, EMPTY_KEY);
+	return table;
+}
+
+// Αναζητά το key (με hash code hash) στον πίνακα table, και επιστρέφει το κελί του ή NULL.
+// Χρησιμοποιείται και από αναζητήσεις χωρίς lock, οπότε το αποτέλεσμα είναι έγκυρο μόνο αν το
+// sequence του stripe δεν άλλαξε στο μεταξύ. Η αναζήτηση τερματίζει (το πολύ capacity βήματα) ακόμα
+// και αν διαβάζει μισοτελειωμένες αλλαγές.
+
+static Slot find_slot(ConcurrentMap map, Table table, Pointer key, uint hash) {
+	uint mask = table->capacity - 1;
+	uint pos = hash & mask;
+	for (int i = 0; i < table->capacity; i++, pos = (pos + 1) & mask) {
+		Slot slot = &table->slots[pos];
+		uintptr_t slot_key = atomic_load_explicit(&slot->key, memory_order_relaxed);
+		if (slot_key == EMPTY_KEY)
+			break;
+
+		if (slot_key != DELETED_KEY && atomic_load_explicit(&slot->hash, memory_order_relaxed) == hash &&
+			map->compare((Pointer)slot_key, key) == 0)
+			return slot;
+	}
+	return NULL;
+}
+
+// Τοποθετεί το key (που σίγουρα δεν υπάρχει στον πίνακα) στον τρέχοντα πίνακα του stripe.
+// Καλείται μόνο από writers, που έχουν το lock.
+
+static void place_slot(Stripe stripe, Pointer key, Pointer value, uint hash) {
+	Table table = atomic_load_explicit(&stripe->table, memory_order_relaxed);
+	uint mask = table->capacity - 1;
+	uint pos = hash & mask;
+	while (is_occupied(atomic_load_explicit(&table->slots[pos].key, memory_order_relaxed)))
+		pos = (pos + 1) & mask;
+
+	Slot slot = &table->slots[pos];
+	if (atomic_load_explicit(&slot->key, memory_order_relaxed) == EMPTY_KEY)
+		stripe->used++;
+
+	atomic_store_explicit(&slot->hash, hash, memory_order_relaxed);
+	atomic_store_explicit(&slot->value, value, memory_order_relaxed);
+	atomic_store_explicit(&slot->key, (uintptr_t)key, memory_order_relaxed);
+}
+
+// Επιστρέφει έναν κενό πίνακα με capacity κελιά για το rehash του stripe: έναν από τους retired, αν
+// υπάρχει με αυτό το μέγεθος, διαφορετικά καινούριο. Κάποια αναζήτηση μπορεί ακόμα να διαβάζει τον
+// retired πίνακα, οπότε τα κελιά του αδειάζουν με atomic εγγραφές.
+
+static Table take_table(Stripe stripe, int capacity) {
+	for (Table* link = &stripe->retired; *link != NULL; link = &(*link)->retired_next) {
+		Table table = *link;
+		if (table->capacity == capacity) {
+			*link = table->retired_next;
+			table->retired_next = NULL;
+			for (int i = 0; i < capacity; i++)
+				atomic_store_explicit(&table->slots[i].key, EMPTY_KEY, memory_order_relaxed);
+			return table;
+		}
+	}
+	return create_table(capacity);
+}
+
+// Μεταφέρει το πολύ budget κελιά του old_table στον table. Όταν μεταφερθούν όλα, ο παλιός πίνακας
+// μπαίνει στη λίστα retired (κάποια αναζήτηση μπορεί ακόμα να τον διαβάζει).
+
+static void rehash_step(Stripe stripe, int budget) {
+	Table old = atomic_load_explicit(&stripe->old_table, memory_order_relaxed);
+	if (old == NULL)
+		return;
+
+	for (; budget > 0 && stripe->rehash_index < old->capacity; budget--) {
+		Slot slot = &old->slots[stripe->rehash_index++];
+		uintptr_t key = atomic_load_explicit(&slot->key, memory_order_relaxed);
+		if (is_occupied(key)) {
+			place_slot(stripe, (Pointer)key,
+				atomic_load_explicit(&slot->value, memory_order_relaxed),
+				atomic_load_explicit(&slot->hash, memory_order_relaxed));
+
+			// Το κελί δεν πρέπει να ξαναβρεθεί στον παλιό πίνακα (πχ αν το key αφαιρεθεί από τον νέο)
+			atomic_store_explicit(&slot->key, DELETED_KEY, memory_order_relaxed);
+		}
+	}
+
+	if (stripe->rehash_index == old->capacity) {
+		old->retired_next = stripe->retired;
+		stripe->retired = old;
+		atomic_store_explicit(&stripe->old_table, NULL, memory_order_relaxed);
+	}
+}
+
+// Ξεκινάει rehash του stripe σε νέο πίνακα: διπλάσιο, ή ίδιου μεγέθους αν ο πίνακας γέμισε κυρίως
+// από DELETED κελιά (οπότε απλά καθαρίζουν).
+
+static void start_rehash(Stripe stripe) {
+	// Αν δεν έχει τελειώσει το προηγούμενο rehash (σπάνιο, μόνο με πολλές διαγραφές), το ολοκληρώνουμε
+	rehash_step(stripe, INT32_MAX);
+
+	Table table = atomic_load_explicit(&stripe->table, memory_order_relaxed);
+	int size = atomic_load_explicit(&stripe->size, memory_order_relaxed);
+	int capacity = size + 1 > table->capacity * MAX_LOAD_FACTOR / 2 ? table->capacity * 2 : table->capacity;
+
+	// Ο νέος πίνακας δημοσιεύεται με release, ώστε όποιος τον διαβάσει να βλέπει και τα (κενά) κελιά του
+	atomic_store_explicit(&stripe->old_table, table, memory_order_relaxed);
+	atomic_store_explicit(&stripe->table, take_table(stripe, capacity), memory_order_release);
+	stripe->rehash_index = 0;
+	stripe->used = 0;
+}
+
+// Αρχή και τέλος μιας τροποποίησης του stripe (seqlock)
+
+static void write_begin(Stripe stripe) {
+	pthread_mutex_lock(&stripe->lock);
+	uint sequence = atomic_load_explicit(&stripe->sequence, memory_order_relaxed);
+	atomic_store_explicit(&stripe->sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+}
+
+static void write_end(Stripe stripe) {
+	uint sequence = atomic_load_explicit(&stripe->sequence, memory_order_relaxed);
+	atomic_store_explicit(&stripe->sequence, sequence + 1, memory_order_release);
+	pthread_mutex_unlock(&stripe->lock);
+}
+
+
+ConcurrentMap concurrent_map_create(CompareFunc compare, HashFunc hash_function) {
+	ConcurrentMap map = aligned_alloc(64, sizeof(*map));
+
+	for (int i = 0; i < STRIPES; i++) {
+		Stripe stripe = &map->stripes[i];
+		atomic_init(&stripe->sequence, 0);
+		pthread_mutex_init(&stripe->lock, NULL);
+		atomic_init(&stripe->table, create_table(INITIAL_CAPACITY));
+		atomic_init(&stripe->old_table, NULL);
+		stripe->rehash_index = 0;
+		stripe->used = 0;
+		atomic_init(&stripe->size, 0);
+		stripe->retired = NULL;
+	}
+	map->compare = compare;
+	map->hash_function = hash_function;
+
+	return map;
+}
+
+int concurrent_map_size(ConcurrentMap map) {
+	int size = 0;
+	for (int i = 0; i < STRIPES; i++)
+		size += atomic_load_explicit(&map->stripes[i].size, memory_order_relaxed);
+	return size;
+}
+
+size_t concurrent_map_memory(ConcurrentMap map) {
+	size_t bytes = 0;
+	for (int i = 0; i < STRIPES; i++) {
+		Stripe stripe = &map->stripes[i];
+		pthread_mutex_lock(&stripe->lock);
+		Table old = atomic_load_explicit(&stripe->old_table, memory_order_relaxed);
+		Table tables[] = { atomic_load_explicit(&stripe->table, memory_order_relaxed), old };
+		for (int t = 0; t < 2; t++)
+			if (tables[t] != NULL)
+				bytes += sizeof(struct table) + tables[t]->capacity * sizeof(struct slot);
+		for (Table table = stripe->retired; table != NULL; table = table->retired_next)
+			bytes += sizeof(struct table) + table->capacity * sizeof(struct slot);
+		pthread_mutex_unlock(&stripe->lock);
+	}
+	return bytes;
+}
+
+void concurrent_map_insert(ConcurrentMap map, Pointer key, Pointer value) {
+	uint hash = mix_hash(map->hash_function(key));
+	Stripe stripe = stripe_of(map, hash);
+
+	write_begin(stripe);
+	rehash_step(stripe, REHASH_BUDGET);
+
+	// Αν το key υπάρχει ήδη στον τρέχοντα πίνακα, αντικαθιστούμε key/value
+	Slot slot = find_slot(map, atomic_load_explicit(&stripe->table, memory_order_relaxed), key, hash);
+	if (slot != NULL) {
+		atomic_store_explicit(&slot->value, value, memory_order_relaxed);
+		atomic_store_explicit(&slot->key, (uintptr_t)key, memory_order_relaxed);
+		write_end(stripe);
+		return;
+	}
+
+	// Αν υπάρχει στον παλιό πίνακα (δεν έχει μεταφερθεί ακόμα), το αφαιρούμε από εκεί και το
+	// προσθέτουμε στον τρέχοντα σαν νέο
+	Table old = atomic_load_explicit(&stripe->old_table, memory_order_relaxed);
+	slot = old != NULL ? find_slot(map, old, key, hash) : NULL;
+	if (slot != NULL) {
+		atomic_store_explicit(&slot->key, DELETED_KEY, memory_order_relaxed);
+		atomic_fetch_sub_explicit(&stripe->size, 1, memory_order_relaxed);
+	}
+
+	Table table = atomic_load_explicit(&stripe->table, memory_order_relaxed);
+	if (stripe->used + 1 > table->capacity * MAX_LOAD_FACTOR)
+		start_rehash(stripe);
+
+	place_slot(stripe, key, value, hash);
+	atomic_fetch_add_explicit(&stripe->size, 1, memory_order_relaxed);
+
+	write_end(stripe);
+}
+
+bool concurrent_map_remove(ConcurrentMap map, Pointer key) {
+	uint hash = mix_hash(map->hash_function(key));
+	Stripe stripe = stripe_of(map, hash);
+
+	write_begin(stripe);
+	rehash_step(stripe, REHASH_BUDGET);
+
+	Slot slot = find_slot(map, atomic_load_explicit(&stripe->table, memory_order_relaxed), key, hash);
+	Table old = atomic_load_explicit(&stripe->old_table, memory_order_relaxed);
+	if (slot == NULL && old != NULL)
+		slot = find_slot(map, old, key, hash);
+
+	if (slot != NULL) {
+		atomic_store_explicit(&slot->key, DELETED_KEY, memory_order_relaxed);
+		atomic_fetch_sub_explicit(&stripe->size, 1, memory_order_relaxed);
+	}
+
+	write_end(stripe);
+	return slot != NULL;
+}
+
+Pointer concurrent_map_find(ConcurrentMap map, Pointer key) {
+	uint hash = mix_hash(map->hash_function(key));
+	Stripe stripe = stripe_of(map, hash);
+
+	while (true) {
+		// Αν γίνεται τροποποίηση, περιμένουμε να τελειώσει. Το sched_yield δίνει τη σειρά του στον writer
+		// (που μπορεί να περιμένει να εκτελεστεί στον ίδιο επεξεργαστή).
+		uint sequence = atomic_load_explicit(&stripe->sequence, memory_order_acquire);
+		if (sequence & 1) {
+			sched_yield();
+			continue;
+		}
+
+		Table table = atomic_load_explicit(&stripe->table, memory_order_acquire);
+		Table old = atomic_load_explicit(&stripe->old_table, memory_order_acquire);
+		Slot slot = find_slot(map, table, key, hash);
+		if (slot == NULL && old != NULL)
+			slot = find_slot(map, old, key, hash);
+		Pointer value = slot != NULL ? atomic_load_explicit(&slot->value, memory_order_relaxed) : NULL;
+
+		// Το αποτέλεσμα ισχύει μόνο αν καμία τροποποίηση δεν ξεκίνησε στο μεταξύ
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&stripe->sequence, memory_order_relaxed) == sequence)
+			return value;
+	}
+}
+
+void concurrent_map_destroy(ConcurrentMap map) {
+	for (int i = 0; i < STRIPES; i++) {
+		Stripe stripe = &map->stripes[i];
+		free(atomic_load(&stripe->table));
+		free(atomic_load(&stripe->old_table));
+		while (stripe->retired != NULL) {
+			Table next = stripe->retired->retired_next;
+			free(stripe->retired);
+			stripe->retired = next;
+		}
+		pthread_mutex_destroy(&stripe->lock);
+	}
+	free(map);
+}
@@ -5,17 +5,27 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "ADTMap.h"
+#include "hash_functions.h"
 
 
 // Οι κόμβοι του map στην υλοποίηση με hash table, μπορούν να είναι σε 3 διαφορετικές καταστάσεις,
 // ώστε αν διαγράψουμε κάποιον κόμβο, αυτός να μην είναι empty, ώστε να μην επηρεάζεται η αναζήτηση
 // αλλά ούτε occupied, ώστε η εισαγωγή να μπορεί να το κάνει overwrite.
-typedef enum {
-	EMPTY, OCCUPIED, DELETED
-} State;
+//
+// Για να έχει ο κόμβος μόνο δύο λέξεις (16 bytes), η κατάσταση κωδικοποιείται στο key: οι EMPTY και DELETED κόμβοι
+// έχουν ως key τη διεύθυνση ενός από τα δύο bytes του sentinels, την οποία ο χρήστης δεν μπορεί να έχει ως key
+// (οπότε επιτρέπεται και key NULL). Δεν κάνουμε καμία υπόθεση για τα bits των pointers (πχ ότι τα υψηλά είναι 0).
+static char sentinels[2];
+#define EMPTY_KEY ((Pointer)&sentinels[0])
+#define DELETED_KEY ((Pointer)&sentinels[1])
 
 // Το μέγεθος του Hash Table ιδανικά θέλουμε να είναι πρώτος αριθμός σύμφωνα με την θεωρία.
 // Η παρακάτω λίστα περιέχει πρώτους οι οποίοι έχουν αποδεδιγμένα καλή συμπεριφορά ως μεγέθη.
@@ -23,15 +33,81 @@ typedef enum {
 int prime_sizes[] = {53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 393241,
 	786433, 1572869, 3145739, 6291469, 12582917, 25165843, 50331653, 100663319, 201326611, 402653189, 805306457, 1610612741};
 
+// Στο MAP_SIZE_POWER_OF_TWO τα μεγέθη είναι δυνάμεις του 2, ξεκινώντας από το παρακάτω.
+// Το μέγιστο μέγεθος είναι 2^30, το μεγαλύτερο που χωράει σε int.
+#define POW2_INITIAL_CAPACITY 64
+#define POW2_MAX_CAPACITY (1 << 30)
+
+// Σταθερά του Fibonacci hashing: 2^32 / φ. Πολλαπλασιάζοντας με αυτή, τα bits του hash code "ανακατεύονται"
+// προς τα υψηλά bits, οπότε ακόμα και διαδοχικά hash codes (πχ από τη hash_int) σκορπίζονται σε όλο τον πίνακα.
+#define FIBONACCI_MULTIPLIER 2654435769u
+
 // Χρησιμοποιούμε open addressing, οπότε σύμφωνα με την θεωρία, πρέπει πάντα να διατηρούμε
 // τον load factor του  hash table μικρότερο ή ίσο του 0.5, για να έχουμε αποδoτικές πράξεις
 #define MAX_LOAD_FACTOR 0.5
 
+// Αντίστοιχα, όταν μετά από διαγραφές τα στοιχεία πέσουν κάτω από αυτό το load factor, μικραίνουμε τον πίνακα
+// (ώστε να μη σπαταλάμε μνήμη, και η διάσχιση να μην κοστίζει O(capacity) για λίγα στοιχεία).
+// Η τιμή είναι αρκετά μικρότερη από το MAX_LOAD_FACTOR / 2 που έχει ο πίνακας μετά από κάθε rehash,
+// ώστε εναλλασσόμενες εισαγωγές/διαγραφές να μην προκαλούν συνεχώς rehash.
+#define MIN_LOAD_FACTOR 0.0625
+
+// Με background rehash, ο επόμενος πίνακας αρχίζει να ετοιμάζεται από βοηθητικό thread μόλις ο load factor
+// φτάσει αυτή την τιμή, ώστε να είναι έτοιμος όταν φτάσουμε στο MAX_LOAD_FACTOR.
+#define PREALLOC_LOAD_FACTOR 0.375
+
+// Οι λειτουργίες map_find_many/map_insert_many επεξεργάζονται τα keys σε ομάδες αυτού του μεγέθους,
+// ώστε τα hash codes και οι θέσεις μιας ομάδας να χωράνε άνετα σε τοπικούς πίνακες.
+#define BATCH_SIZE 16
+
+// Αν μια εισαγωγή χρειαστεί να εξετάσει περισσότερα κελιά από αυτό το όριο, θεωρούμε ότι τα keys έχουν επιλεγεί
+// ώστε να συγκρούονται (hash flooding). Με load factor <= 0.5 και καλή συνάρτηση κατακερματισμού, τόσο μεγάλες
+// αλυσίδες στην πράξη δεν εμφανίζονται ποτέ.
+#define FLOOD_PROBE_LIMIT 128
+
+// Στη map_build_parallel κάθε thread αναλαμβάνει τουλάχιστον τόσα κελιά του πίνακα, ώστε σε μικρά maps
+// να μη δημιουργούνται threads που δεν έχουν σχεδόν καθόλου δουλειά.
+#define BUILD_MIN_REGION 4096
+
+// Στρογγυλοποίηση προς τα πάνω σε πολλαπλάσιο του 8, ώστε οι λέξεις των κόμβων να είναι ευθυγραμμισμένες
+#define ALIGN8(size) (((size) + 7) & ~(size_t)7)
+
+// Πόσα κελιά του παλιού πίνακα μεταφέρονται, εξ ορισμού, σε κάθε λειτουργία κατά το incremental rehash.
+// Οι αναζητήσεις μεταφέρουν λιγότερα, αρκετά όμως ώστε ένα map που διαβάζεται κυρίως να ολοκληρώνει το rehash.
+#define DEFAULT_REHASH_BUDGET 2
+#define DEFAULT_FIND_REHASH_BUDGET 1
+
+// Μεγέθη των blocks του arena της map_insert_copy_string: το πρώτο block είναι μικρό (για μικρά maps),
+// κάθε επόμενο διπλάσιο, μέχρι το μέγιστο.
+#define ARENA_INITIAL_BLOCK 4096
+#define ARENA_MAX_BLOCK (1 << 20)
+
+// Το arena συμπυκνώνεται σε ένα rehash μόνο αν τα αντίγραφα keys που έχουν διαγραφεί ξεπερνούν αυτό το ποσοστό
+// του, ώστε ένα map που απλά μεγαλώνει να μην αντιγράφει ξανά όλα τα keys σε κάθε rehash.
+#define ARENA_MAX_GARBAGE 0.25
+
 // Δομή του κάθε κόμβου που έχει το hash table (με το οποίο υλοιποιούμε το map)
 struct map_node{
-	Pointer key;		// Το κλειδί που χρησιμοποιείται για να hash-αρουμε
-	Pointer value;  	// Η τιμή που αντισοιχίζεται στο παραπάνω κλειδί
-	State state;		// Μεταβλητή για να μαρκάρουμε την κατάσταση των κόμβων (βλέπε διαγραφή)
+	Pointer key;			// Το κλειδί που χρησιμοποιείται για να hash-αρουμε (ή EMPTY_KEY/DELETED_KEY)
+	Pointer value;  		// Η τιμή που αντισοιχίζεται στο παραπάνω κλειδί
+};
+
+_Static_assert(sizeof(struct map_node) == 16, "ο κόμβος πρέπει να είναι 2 λέξεις των 64 bits");
+
+// Οι OCCUPIED κόμβοι έχουν key διαφορετικό από τα δύο διαδοχικά sentinels (μία σύγκριση αντί για δύο)
+
+static inline bool is_occupied(MapNode node) {
+	return (uintptr_t)node->key - (uintptr_t)EMPTY_KEY > 1;
+}
+
+// Ενα block του arena. Τα blocks σχηματίζουν λίστα, από το τρέχον (στο οποίο γίνονται οι νέες αντιγραφές) προς τα παλιότερα.
+typedef struct arena_block* ArenaBlock;
+
+struct arena_block {
+	ArenaBlock next;
+	size_t capacity;			// Πόσα bytes χωράει το data
+	size_t used;				// Πόσα bytes έχουν χρησιμοποιηθεί
+	char data[];
 };
 
 // Δομή του Map (περιέχει όλες τις πληροφορίες που χρεαζόμαστε για το HashTable)
@@ -39,38 +115,241 @@ struct map {
 	MapNode array;				// Ο πίνακας που θα χρησιμοποιήσουμε για το map (remember, φτιάχνουμε ένα hash table)
 	int capacity;				// Πόσο χώρο έχουμε δεσμεύσει.
 	int size;					// Πόσα στοιχεία έχουμε προσθέσει
-	int deleted;				// Πόσα κελιά είναι DELETED
+	int deleted;				// Πόσα κελιά είναι DELETED (μόνο στον τρέχοντα πίνακα)
+	MapSizing sizing;			// Πρώτοι αριθμοί ή δυνάμεις του 2 ως μεγέθη πίνακα
+	int reserved;				// Πόσα στοιχεία έχει ζητήσει ο χρήστης να χωράνε χωρίς rehash (map_reserve)
 	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
 	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	SeededHashFunc seeded_hash;	// Η seeded εκδοχή της hash_function, αν είναι μία από τις hash_string/hash_int/hash_pointer
+	uint64_t seed;				// Το seed του map για τις seeded συναρτήσεις κατακερματισμού
+	uint64_t salt;				// Αν δεν είναι 0, οι θέσεις υπολογίζονται από το hash code ανακατεμένο με το salt (βλ. hash flooding)
+	int flood_capacity;			// Το capacity στο οποίο αντιμετωπίστηκε τελευταία φορά hash flooding
 	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
 	DestroyFunc destroy_value;
 
+	// Με inline αποθήκευση (map_create_inline), κάθε κόμβος είναι η λέξη key (μόνο για την κατάσταση του κόμβου,
+	// NULL στους OCCUPIED), ακολουθούμενη από τα key_size bytes του key και τα value_size bytes του value (στο value_offset).
+	bool inline_storage;
+	size_t key_size;
+	size_t value_size;
+	size_t value_offset;
+	size_t node_size;			// Το μέγεθος κάθε κόμβου στους πίνακες (sizeof(struct map_node) χωρίς inline αποθήκευση)
+
+	// Τα αντίγραφα των keys της map_insert_copy_string. Κατά τη διάρκεια ενός rehash που συμπυκνώνει το arena,
+	// τα keys του παλιού πίνακα βρίσκονται στο old_arena, και αντιγράφονται στο arena καθώς μεταφέρονται
+	// (οπότε μένουν μόνο τα ζωντανά).
+	ArenaBlock arena;
+	ArenaBlock old_arena;
+	size_t arena_used;			// Πόσα bytes του arena έχουν χρησιμοποιηθεί
+	size_t arena_garbage;		// Πόσα από αυτά ανήκουν σε keys που έχουν διαγραφεί
+
 	// Πεδία που έχουμε προσθέσει για το incremental rehash.
 	// Προσθέστε επιπλέον πεδία, αν χρειαστούν.
 	//
 	MapNode old_array;			// Ο παλιός πίνακας από τον οποίο κάνουμε incremental rehash
 	int old_capacity;			// Πόσο χώρο είχαμε δεσμεύσει στον παλιό πίνακα
 	int rehash_index; 			// Δείκτης για το σημείο που βρισκόμαστε στο rehashing
+	int rehash_budget;			// Πόσα κελιά μεταφέρονται σε κάθε map_insert/map_remove
+	int find_rehash_budget;		// Πόσα κελιά μεταφέρονται σε κάθε map_find (με 0 οι αναζητήσεις δεν τροποποιούν το map)
+
+	// Πεδία για το background rehash. Το βοηθητικό thread δεν αγγίζει ποτέ το map, μόνο
+	// τον πίνακα που δημιουργεί, τον οποίο παίρνουμε με pthread_join.
+	bool background;			// Αν οι νέοι πίνακες ετοιμάζονται/αποδεσμεύονται από βοηθητικά threads
+	bool prealloc_pending;		// Αν έχει ξεκινήσει thread που ετοιμάζει τον επόμενο πίνακα
+	pthread_t prealloc_thread;	// Το thread αυτό
+	int prealloc_capacity;		// Το μέγεθος του πίνακα που ετοιμάζει
+
+	MapStats stats;				// Στατιστικά για το πόσες φορές ακολουθήθηκε κάθε δρόμος του rehash
 };
 
 
+// Ο κόμβος στη θέση pos του πίνακα array (οι κόμβοι έχουν μέγεθος map->node_size)
+
+static inline MapNode node_at(Map map, MapNode array, uint pos) {
+	return (MapNode)((char*)array + (size_t)pos * map->node_size);
+}
+
+// Η θέση του κόμβου node στον πίνακα array
+
+static inline int node_index(Map map, MapNode array, MapNode node) {
+	return ((char*)node - (char*)array) / map->node_size;
+}
+
+static inline bool in_array(Map map, MapNode array, int capacity, MapNode node) {
+	return (char*)node >= (char*)array && (char*)node < (char*)array + (size_t)capacity * map->node_size;
+}
+
+// Το key και το value ενός κόμβου. Με inline αποθήκευση είναι δείκτες μέσα στον ίδιο τον κόμβο.
+
+static inline Pointer node_key(Map map, MapNode node) {
+	return map->inline_storage ? (Pointer)&node->value : node->key;
+}
+
+static inline Pointer node_value(Map map, MapNode node) {
+	return map->inline_storage ? (Pointer)((char*)node + map->value_offset) : node->value;
+}
+
+// Αποθηκεύει στον κόμβο το key, αντιγράφοντας τα περιεχόμενά του αν η αποθήκευση είναι inline.
+// Χρησιμοποιούμε memmove, γιατί το key/value μπορεί να είναι δείκτης στον ίδιο τον κόμβο (πχ από map_node_value).
+
+static inline void store_key(Map map, MapNode node, Pointer key) {
+	if (map->inline_storage) {
+		node->key = NULL;
+		memmove(&node->value, key, map->key_size);
+	} else {
+		node->key = key;
+	}
+}
+
+static inline void store_value(Map map, MapNode node, Pointer value) {
+	if (!map->inline_storage)
+		node->value = value;
+	else if (value != NULL)
+		memmove(node_value(map, node), value, map->value_size);
+	else
+		memset(node_value(map, node), 0, map->value_size);
+}
+
+// Αντιγράφει το string στο arena του map (σε νέο block, αν δε χωράει στο τρέχον) και επιστρέφει το αντίγραφο
+
+static char* arena_copy(Map map, const char* string) {
+	size_t length = strlen(string) + 1;
+	map->arena_used += length;
+
+	ArenaBlock block = map->arena;
+	if (block == NULL || block->used + length > block->capacity) {
+		size_t capacity = block == NULL ? ARENA_INITIAL_BLOCK : block->capacity * 2;
+		if (capacity > ARENA_MAX_BLOCK)
+			capacity = ARENA_MAX_BLOCK;
+		if (capacity < length)
+			capacity = length;			// πολύ μεγάλο string, σε δικό του block
+
+		ArenaBlock new_block = malloc(sizeof(*new_block) + capacity);
+		new_block->next = block;
+		new_block->capacity = capacity;
+		new_block->used = 0;
+		map->arena = block = new_block;
+	}
+
+	char* copy = block->data + block->used;
+	memcpy(copy, string, length);
+	block->used += length;
+	return copy;
+}
+
+static void arena_free(ArenaBlock arena) {
+	while (arena != NULL) {
+		ArenaBlock next = arena->next;
+		free(arena);
+		arena = next;
+	}
+}
+
+// Δημιουργεί έναν πίνακα capacity κόμβων (μεγέθους node_size), όλων σε κατάσταση EMPTY
+
+static MapNode create_array(int capacity, size_t node_size) {
+	char* array = malloc(capacity * node_size);
+	for (int i = 0; i < capacity; i++)
+		((MapNode)(array + i * node_size))->key = EMPTY_KEY;
+	return (MapNode)array;
+}
+
+// Επιστρέφει το επόμενο μέγεθος πίνακα, μεγαλύτερο από capacity, ανάλογα με το map->sizing
+
+static int next_capacity(Map map, int capacity) {
+	if (map->sizing == MAP_SIZE_POWER_OF_TWO)
+		return capacity < POW2_MAX_CAPACITY ? capacity * 2 : capacity;
+
+	int prime_count = sizeof(prime_sizes) / sizeof(prime_sizes[0]);
+	for (int i = 0; i < prime_count; i++)
+		if (prime_sizes[i] > capacity)
+			return prime_sizes[i];
+	return capacity;
+}
+
+// Επιστρέφει το μικρότερο μέγεθος πίνακα (ανάλογα με το map->sizing) στο οποίο entries στοιχεία έχουν load factor <= load
+
+static int capacity_for(Map map, int entries, double load) {
+	int capacity = map->sizing == MAP_SIZE_POWER_OF_TWO ? POW2_INITIAL_CAPACITY : prime_sizes[0];
+	while (entries > capacity * load) {
+		int next = next_capacity(map, capacity);
+		if (next == capacity)
+			break;
+		capacity = next;
+	}
+	return capacity;
+}
+
+// Το μέγεθος στο οποίο μικραίνει ο πίνακας σε purge/shrink: το μικρότερο που έχει load factor MAX_LOAD_FACTOR / 2
+// για τα τρέχοντα στοιχεία, αλλά όχι μικρότερο από αυτό που χρειάζεται για όσα στοιχεία έχουν δεσμευτεί με map_reserve.
+
+static int shrunk_capacity(Map map) {
+	int capacity = capacity_for(map, map->size, MAX_LOAD_FACTOR / 2);
+	int reserved = capacity_for(map, map->reserved, MAX_LOAD_FACTOR);
+	return capacity > reserved ? capacity : reserved;
+}
+
+// Το seed που παίρνουν όλα τα maps κατά τη δημιουργία τους. Επιλέγεται τυχαία μία φορά ανά εκτέλεση του
+// προγράμματος, ώστε να μην μπορεί να προβλεφθεί, αλλά να είναι κοινό και τα hash codes της map_hash να
+// μπορούν να χρησιμοποιηθούν σε όλα τα maps.
+
+static uint64_t process_seed;
+static pthread_once_t process_seed_once = PTHREAD_ONCE_INIT;
+
+static uint64_t mix64(uint64_t x) {
+	// Ο finalizer του splitmix64
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+static void init_process_seed(void) {
+	// Η διεύθυνση μιας static μεταβλητής διαφέρει σε κάθε εκτέλεση (ASLR), και ο χρόνος επίσης
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	process_seed = mix64((uintptr_t)&process_seed ^ mix64(now.tv_sec) ^ now.tv_nsec);
+}
+
+static uint64_t default_seed(void) {
+	pthread_once(&process_seed_once, init_process_seed);
+	return process_seed;
+}
+
 Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
 	// Δεσμεύουμε κατάλληλα τον χώρο που χρειαζόμαστε για το hash table
 	Map map = malloc(sizeof(*map));
+	map->sizing = MAP_SIZE_PRIME;
 	map->capacity = prime_sizes[0];
-	map->array = malloc(map->capacity * sizeof(struct map_node));
+	map->inline_storage = false;
+	map->key_size = 0;
+	map->value_size = 0;
+	map->value_offset = 0;
+	map->node_size = sizeof(struct map_node);
+	map->arena = NULL;
+	map->old_arena = NULL;
+	map->arena_used = 0;
+	map->arena_garbage = 0;
+	map->array = create_array(map->capacity, map->node_size);
 
 	// Σε ένα καινούριο map ο παλιός πίνακας είναι απλά κενός
 	map->old_capacity = 0;
 	map->old_array = NULL;
-
-	// Αρχικοποιούμε τους κόμβους που έχουμε σαν διαθέσιμους.
-	for (int i = 0; i < map->capacity; i++)
-		map->array[i].state = EMPTY;
+	map->rehash_index = 0;
+	map->rehash_budget = DEFAULT_REHASH_BUDGET;
+	map->find_rehash_budget = DEFAULT_FIND_REHASH_BUDGET;
+	map->background = false;
+	map->prealloc_pending = false;
 
 	map->size = 0;
 	map->deleted = 0;
+	map->reserved = 0;
+	map->stats = (MapStats){ 0 };
 	map->compare = compare;
+	map->hash_function = NULL;
+	map->seeded_hash = NULL;
+	map->seed = default_seed();
+	map->salt = 0;
+	map->flood_capacity = 0;
 	map->destroy_key = destroy_key;
 	map->destroy_value = destroy_value;
 
@@ -82,143 +361,533 @@ int map_size(Map map) {
 	return map->size;
 }
 
-// Εισαγωγή στο hash table του ζευγαριού (key, item). Αν το key υπάρχει,
-// ανανέωση του με ένα νέο value, και η συνάρτηση επιστρέφει true.
+// Το hash code του key: η seeded συνάρτηση με το seed του map αν υπάρχει, αλλιώς η hash_function του χρήστη
+
+static inline uint hash_key(Map map, Pointer key) {
+	return map->seeded_hash != NULL ? map->seeded_hash(key, map->seed) : map->hash_function(key);
+}
+
+// Η θέση στην οποία κάνει hash ένα hash code, σε πίνακα μεγέθους capacity.
+// Στις δυνάμεις του 2 κρατάμε τα υψηλά bits του (hash * FIBONACCI_MULTIPLIER), αποφεύγοντας τη διαίρεση.
+// Μετά από hash flooding, το hash code ανακατεύεται πρώτα με το (τυχαίο) salt του map.
+
+static inline uint home_pos(Map map, uint hash, int capacity) {
+	if (map->salt != 0)
+		hash = mix64(hash ^ map->salt);
+
+	if (map->sizing == MAP_SIZE_POWER_OF_TWO)
+		return (hash * FIBONACCI_MULTIPLIER) >> (32 - __builtin_ctz(capacity));
+	else
+		return hash % capacity;
+}
+
+// Η επόμενη θέση στο linear probing, γυρνώντας στην αρχή όταν φτάσουμε στο τέλος του πίνακα.
+// Δεν χρειάζεται το %, που είναι διαίρεση σε κάθε βήμα, αρκεί μια σύγκριση (ή ένα mask στις δυνάμεις του 2).
+
+static inline uint next_pos(Map map, uint pos, int capacity) {
+	if (map->sizing == MAP_SIZE_POWER_OF_TWO)
+		return (pos + 1) & (capacity - 1);
+	else
+		return pos + 1 == (uint)capacity ? 0 : pos + 1;
+}
+
+// Αν ο (μη EMPTY) κόμβος node περιέχει το key. Ο κόμβος έχει μόνο key και value (16 bytes), χωρίς το hash code
+// του key, οπότε η compare καλείται για κάθε OCCUPIED κόμβο της αλυσίδας.
+
+static inline bool has_key(Map map, MapNode node, Pointer key) {
+	return node->key != DELETED_KEY && map->compare(node_key(map, node), key) == 0;
+}
+
+// Αναζητά στον πίνακα array (μεγέθους capacity) τον κόμβο με κλειδί key, του οποίου το hash code είναι hash.
+
+static MapNode find_node_in(Map map, MapNode array, int capacity, Pointer key, uint hash) {
+	int count = 0;
+	for (uint pos = home_pos(map, hash, capacity);					// ξεκινώντας από τη θέση που κάνει hash το key
+		node_at(map, array, pos)->key != EMPTY_KEY && count < capacity;		// αν φτάσουμε σε EMPTY (ή ελέγξουμε όλο τον πίνακα) σταματάμε
+		pos = next_pos(map, pos, capacity), count++) {						// linear probing
+
+		if (has_key(map, node_at(map, array, pos), key))
+			return node_at(map, array, pos);
+	}
+	return MAP_EOF;
+}
+
+// Αναζητά τον κόμβο με κλειδί key και hash code hash, πρώτα στον τρέχοντα και μετά στον παλιό πίνακα.
+// Με update_stats ενημερώνονται και τα old_lookups/old_hits, οπότε οι αναζητήσεις που δεν πρέπει να
+// τροποποιούν το map (map_find_node, map_find με find_rehash_budget 0) το καλούν με false.
+
+static MapNode find_node(Map map, Pointer key, uint hash, bool update_stats) {
+	// Αναζήτηση στον τρέχοντα πίνακα
+	MapNode node = find_node_in(map, map->array, map->capacity, key, hash);
+
+	// Αν το στοιχείο δεν βρέθηκε, αναζήτηση στον παλιό πίνακα
+	if (node == MAP_EOF && map->old_array != NULL) {
+		node = find_node_in(map, map->old_array, map->old_capacity, key, hash);
+
+		if (update_stats) {
+			map->stats.old_lookups++;
+			if (node != MAP_EOF)
+				map->stats.old_hits++;
+		}
+	}
+
+	return node;
+}
+
+// Τοποθετεί τον κόμβο node, με hash code hash, του οποίου το key σίγουρα δεν υπάρχει στον τρέχοντα πίνακα, στην
+// πρώτη ελεύθερη θέση (χωρίς κλήσεις της compare). Το hash code δεν αποθηκεύεται στους κόμβους, οπότε
+// όποιος μεταφέρει έναν κόμβο το υπολογίζει ξανά από το key.
+
+static void place_node(Map map, MapNode node, uint hash) {
+	uint pos = home_pos(map, hash, map->capacity);
+	while (is_occupied(node_at(map, map->array, pos)))
+		pos = next_pos(map, pos, map->capacity);
+
+	MapNode target = node_at(map, map->array, pos);
+	if (target->key == DELETED_KEY)
+		map->deleted--;
+	memcpy(target, node, map->node_size);
+}
+
+// Συναρτήσεις που εκτελούνται από τα βοηθητικά threads του background rehash
+
+// Τα ορίσματα του thread που ετοιμάζει τον επόμενο πίνακα (τα αποδεσμεύει το ίδιο το thread)
+struct prealloc_args {
+	int capacity;
+	size_t node_size;
+};
+
+static void* prealloc_thread_main(void* argument) {
+	struct prealloc_args args = *(struct prealloc_args*)argument;
+	free(argument);
+	return create_array(args.capacity, args.node_size);
+}
+
+static void* free_thread_main(void* array) {
+	free(array);
+	return NULL;
+}
+
+// Ξεκινάει thread που ετοιμάζει (δεσμεύει και αρχικοποιεί) έναν πίνακα μεγέθους capacity.
+// Αν το thread δεν μπορεί να δημιουργηθεί, ο πίνακας απλά θα δημιουργηθεί κανονικά όταν χρειαστεί.
+
+static void start_prealloc(Map map, int capacity) {
+	struct prealloc_args* args = malloc(sizeof(*args));
+	*args = (struct prealloc_args){ capacity, map->node_size };
+	if (pthread_create(&map->prealloc_thread, NULL, prealloc_thread_main, args) == 0) {
+		map->prealloc_pending = true;
+		map->prealloc_capacity = capacity;
+	} else {
+		free(args);
+	}
+}
+
+// Επιστρέφει έναν κενό πίνακα μεγέθους capacity. Αν ένα βοηθητικό thread ετοιμάζει ήδη πίνακα αυτού του
+// μεγέθους, περιμένουμε (συνήθως έχει ήδη τελειώσει) και χρησιμοποιούμε αυτόν.
+
+static MapNode take_array(Map map, int capacity) {
+	if (map->prealloc_pending) {
+		void* array;
+		pthread_join(map->prealloc_thread, &array);
+		map->prealloc_pending = false;
+
+		if (map->prealloc_capacity == capacity)
+			return array;
+		free(array);			// ετοιμάστηκε για grow, αλλά τελικά έγινε purge ή shrink
+	}
+	return create_array(capacity, map->node_size);
+}
+
+// Αποδεσμεύει τον πίνακα array. Με background rehash η αποδέσμευση (που για μεγάλους πίνακες
+// επιστρέφει πολλές σελίδες στο λειτουργικό) γίνεται από ξεχωριστό thread.
+
+static void release_array(Map map, MapNode array) {
+	pthread_t thread;
+	if (map->background && pthread_create(&thread, NULL, free_thread_main, array) == 0)
+		pthread_detach(thread);
+	else
+		free(array);
+}
+
+// Μεταφέρει το πολύ steps κελιά από τον παλιό πίνακα στον καινούργιο (μηχανισμός incremental rehash).
+// Όταν ο παλιός πίνακας αδειάσει, τον αποδεσμεύουμε.
+
+static void rehash_step(Map map, int steps) {
+	if (map->old_array == NULL)
+		return;
+
+	for (int i = 0; i < steps && map->rehash_index < map->old_capacity; i++, map->rehash_index++) {
+		MapNode old_node = node_at(map, map->old_array, map->rehash_index);
+		if (is_occupied(old_node)) {
+			// Το key αντιγράφεται από το παλιό arena στο νέο
+			if (map->old_arena != NULL)
+				old_node->key = arena_copy(map, old_node->key);
+
+			place_node(map, old_node, hash_key(map, node_key(map, old_node)));
+			old_node->key = DELETED_KEY;		// DELETED (όχι EMPTY) ώστε να μη σπάσουμε τις αλυσίδες αναζήτησης του παλιού πίνακα
+		}
+	}
+
+	if (map->rehash_index == map->old_capacity) {
+		release_array(map, map->old_array);
+		arena_free(map->old_arena);
+		map->old_arena = NULL;
+		map->old_array = NULL;
+		map->old_capacity = 0;
+		map->rehash_index = 0;
+	}
+}
+
+// Ξεκινάει incremental rehash προς έναν νέο πίνακα μεγέθους new_capacity.
+
+static void start_rehash(Map map, int new_capacity) {
+	// Αν δεν έχει τελειώσει το προηγούμενο rehash, το ολοκληρώνουμε τώρα, υπάρχει μόνο ένας παλιός πίνακας
+	rehash_step(map, map->old_capacity);
+
+	map->old_array = map->array;
+	map->old_capacity = map->capacity;
+	map->rehash_index = 0;
+
+	map->capacity = new_capacity;
+	map->array = take_array(map, map->capacity);
+
+	// Αν υπάρχουν αρκετά αντίγραφα keys που έχουν διαγραφεί, τα υπόλοιπα keys του παλιού πίνακα θα αντιγραφούν σε νέο arena
+	if (map->arena_garbage > map->arena_used * ARENA_MAX_GARBAGE) {
+		map->old_arena = map->arena;
+		map->arena = NULL;
+		map->arena_used = 0;
+		map->arena_garbage = 0;
+	}
+
+	// Τα DELETED του παλιού πίνακα δεν μεταφέρονται
+	map->deleted = 0;
+	map->stats.longest_probe = 0;
+}
+
+static void rebuild(Map map);
+
+// Καλείται πριν από κάθε εισαγωγή: αν κάποια προηγούμενη εισαγωγή χρειάστηκε πάνω από FLOOD_PROBE_LIMIT
+// κελιά, τα keys συγκρούονται σκόπιμα στις ίδιες θέσεις. Επιλέγουμε ένα νέο τυχαίο salt, ώστε οι θέσεις να
+// μην μπορούν πλέον να προβλεφθούν, και ξαναχτίζουμε τον πίνακα. Τα hash codes δεν αλλάζουν (οπότε οι τιμές
+// της map_hash παραμένουν έγκυρες), και γι' αυτό keys με ακριβώς το ίδιο hash code (πχ από μια αδύναμη
+// συνάρτηση του χρήστη) συνεχίζουν να συγκρούονται. Για αυτά δεν ξαναδοκιμάζουμε στο ίδιο μέγεθος πίνακα, ώστε
+// να μην ξαναχτίζουμε τον πίνακα σε κάθε εισαγωγή (βλ. και τη σημείωση στο ADTMap.h, μετά το MapStats).
+
+static void check_flooding(Map map) {
+	if (map->stats.longest_probe <= FLOOD_PROBE_LIMIT || map->flood_capacity == map->capacity)
+		return;
+
+	map->stats.floods++;
+	map->flood_capacity = map->capacity;
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	map->salt = mix64(map->seed ^ map->salt ^ mix64(now.tv_nsec)) | 1;		// ποτέ 0
+
+	rebuild(map);
+}
+
+// Βρίσκει τον κόμβο στον οποίο θα γίνει η εισαγωγή του key (με hash code hash), χωρίς να αλλάξει το map.
+// Στο already_in_map αποθηκεύεται αν ο κόμβος περιέχει ήδη το key.
+
+static MapNode probe_insert(Map map, Pointer key, uint hash, bool* already_in_map) {
+	// Αν είμαστε στη μέση ενός rehash, το key μπορεί να βρίσκεται ακόμα στον παλιό πίνακα.
+	// Τότε το ενημερώνουμε εκεί, και θα μεταφερθεί μαζί με τα υπόλοιπα.
+	MapNode node = NULL;
+	*already_in_map = false;
+	if (map->old_array != NULL) {
+		node = find_node_in(map, map->old_array, map->old_capacity, key, hash);
+		*already_in_map = node != MAP_EOF;
+	}
 
-void map_insert(Map map, Pointer key, Pointer value) {
 	// Σκανάρουμε το Hash Table μέχρι να βρούμε διαθέσιμη θέση για να τοποθετήσουμε το ζευγάρι,
 	// ή μέχρι να βρούμε το κλειδί ώστε να το αντικαταστήσουμε.
-	bool already_in_map = false;
-	MapNode node = NULL;
 	uint pos;
-	for (pos = map->hash_function(key) % map->capacity;		// ξεκινώντας από τη θέση που κάνει hash το key
-		map->array[pos].state != EMPTY;						// αν φτάσουμε σε EMPTY σταματάμε
-		pos = (pos + 1) % map->capacity) {					// linear probing, γυρνώντας στην αρχή όταν φτάσουμε στη τέλος του πίνακα
+	int probes = 0;
+	for (pos = home_pos(map, hash, map->capacity);						// ξεκινώντας από τη θέση που κάνει hash το key
+		!*already_in_map && node_at(map, map->array, pos)->key != EMPTY_KEY;	// αν φτάσουμε σε EMPTY σταματάμε
+		pos = next_pos(map, pos, map->capacity), probes++) {			// linear probing, γυρνώντας στην αρχή όταν φτάσουμε στη τέλος του πίνακα
 
-		if (map->array[pos].state == DELETED) {
+		MapNode current = node_at(map, map->array, pos);
+		if (current->key == DELETED_KEY) {
 			// Βρήκαμε DELETED θέση. Θα μπορούσαμε να βάλουμε το ζευγάρι εδώ, αλλά _μόνο_ αν το key δεν υπάρχει ήδη.
 			// Οπότε σημειώνουμε τη θέση, αλλά συνεχίζουμε την αναζήτηση, το key μπορεί να βρίσκεται πιο μετά.
 			if (node == NULL)
-				node = &map->array[pos];
+				node = current;
 
-		} else if (map->compare(map->array[pos].key, key) == 0) {
-			already_in_map = true;
-			node = &map->array[pos];						// βρήκαμε το key, το ζευγάρι θα μπει αναγκαστικά εδώ (ακόμα και αν είχαμε προηγουμένως βρει DELETED θέση)
-			break;											// και δε χρειάζεται να συνεχίζουμε την αναζήτηση.
+		} else if (has_key(map, current, key)) {
+			*already_in_map = true;
+			node = current;									// βρήκαμε το key, το ζευγάρι θα μπει αναγκαστικά εδώ (ακόμα και αν είχαμε προηγουμένως βρει DELETED θέση)
+			break;												// και δε χρειάζεται να συνεχίζουμε την αναζήτηση.
 		}
 	}
-	if (node == NULL)										// αν βρήκαμε EMPTY (όχι DELETED, ούτε το key), το node δεν έχει πάρει ακόμα τιμή
-		node = &map->array[pos];
+	if (node == NULL)											// αν βρήκαμε EMPTY (όχι DELETED, ούτε το key), το node δεν έχει πάρει ακόμα τιμή
+		node = node_at(map, map->array, pos);
+
+	if (probes > map->stats.longest_probe)
+		map->stats.longest_probe = probes;
+
+	return node;
+}
+
+// Καταλαμβάνει τον (μη OCCUPIED) κόμβο node που επέστρεψε η probe_insert για ένα νέο key. Ο κόμβος αυτός
+// είναι πάντα στον τρέχοντα πίνακα (στον παλιό βρίσκουμε μόνο keys που υπάρχουν ήδη).
+
+static void occupy_node(Map map, MapNode node, Pointer key) {
+	// Νέο στοιχείο, αυξάνουμε τα συνολικά στοιχεία του map
+	map->size++;
+
+	if (node->key == DELETED_KEY)								// αν βρήκαμε DELETED, θα αλλάξει σε OCCUPIED
+		map->deleted--;
+
+	store_key(map, node, key);
+}
+
+// Ξεκινάει rehash αν, με extra επιπλέον στοιχεία, ξεπερνάμε το μέγιστο load factor. Επιστρέφει true αν ξεκίνησε rehash.
+
+static bool check_load(Map map, int extra) {
+	// Στο load factor μετράμε και τα DELETED, γιατί και αυτά επηρρεάζουν τις αναζητήσεις.
+	float load_factor = (float)(map->size + map->deleted + extra) / map->capacity;
+	if (load_factor > MAX_LOAD_FACTOR) {
+		if (map->size + extra > map->capacity * MAX_LOAD_FACTOR / 2) {
+			// Τα στοιχεία είναι πάνω από τα μισά του επιτρεπτού, διπλασιασμός της χωρητικότητας
+			// (επόμενος πρώτος της λίστας, ή επόμενη δύναμη του 2)
+			start_rehash(map, next_capacity(map, map->capacity));
+			map->stats.grows++;
+		} else {
+			// Το μεγαλύτερο μέρος του load factor είναι DELETED. Δεν χρειάζεται μεγαλύτερος πίνακας, αρκεί
+			// rehash στο ίδιο μέγεθος (ή μικρότερο, αν χωράει) ώστε να μη μεταφερθούν τα DELETED.
+			int capacity = shrunk_capacity(map);
+			start_rehash(map, capacity < map->capacity ? capacity : map->capacity);
+			map->stats.purges++;
+		}
+
+		// Αντιγραφή των πρώτων στοιχείων από τον παλιό πίνακα
+		rehash_step(map, map->rehash_budget);
+		return true;
+
+	} else if (map->background && !map->prealloc_pending && load_factor > PREALLOC_LOAD_FACTOR
+			&& map->size > map->capacity * MAX_LOAD_FACTOR / 2) {
+		// Πλησιάζουμε το MAX_LOAD_FACTOR και το επόμενο rehash θα είναι grow, οπότε ετοιμάζουμε από τώρα τον πίνακα
+		int capacity = next_capacity(map, map->capacity);
+		if (capacity != map->capacity)
+			start_prealloc(map, capacity);
+	}
+	return false;
+}
+
+// Εισαγωγή στο hash table του ζευγαριού (key, item), με ήδη υπολογισμένο hash code. Αν το key υπάρχει,
+// ανανέωση του με ένα νέο value.
+
+void map_insert_hashed(Map map, Pointer key, Pointer value, uint hash) {
+	check_flooding(map);
+
+	bool already_in_map;
+	MapNode node = probe_insert(map, key, hash, &already_in_map);
 
 	// Σε αυτό το σημείο, το node είναι ο κόμβος στον οποίο θα γίνει εισαγωγή.
 	if (already_in_map) {
 		// Αν αντικαθιστούμε παλιά key/value, τa κάνουμε destropy
-		if (node->key != key && map->destroy_key != NULL)
-			map->destroy_key(node->key);
+		if (node_key(map, node) != key && map->destroy_key != NULL)
+			map->destroy_key(node_key(map, node));
 
-		if (node->value != value && map->destroy_value != NULL)
-			map->destroy_value(node->value);
+		if (node_value(map, node) != value && map->destroy_value != NULL)
+			map->destroy_value(node_value(map, node));
 
+		store_key(map, node, key);
 	} else {
-		// Νέο στοιχείο, αυξάνουμε τα συνολικά στοιχεία του map
-		map->size++;
-
-		if (node->state == DELETED)							// αν βρήκαμε DELETED, θα αλλάξει σε OCCUPIED
-			map->deleted--;
+		occupy_node(map, node, key);
 	}
 
-	// Προσθήκη τιμών στον κόμβο
-	node->state = OCCUPIED;
-	node->key = key;
-	node->value = value;
+	// Προσθήκη της τιμής στον κόμβο
+	store_value(map, node, value);
 
-	// Μεταφορά 2 κατα μέγιστο nodes απο τον παλιό πίνακα στον καινούργιο (μηχανισμός incremental rehash)
-	if(map->old_array != NULL) {
-		for(int i = 0; i < 2; i++) {
-			if(map->rehash_index < map->old_capacity) {
-				if(map->old_array[map->rehash_index].state == OCCUPIED) {
-					MapNode old_node = &map->old_array[map->rehash_index];
-					pos = map->hash_function(old_node->key) % map->capacity;
-					while(map->array[pos].state == OCCUPIED) {
-						pos = (pos + 1) % map->capacity;
-					}
-					map->array[pos] = *old_node;
-				}
-				map->rehash_index++;
-			} else {
-				free(map->old_array);
-				map->old_array = NULL;
-				map->old_capacity = 0;
-				map->rehash_index = 0;
-				break;
-			}
-		}
-	}
+	// Μεταφορά rehash_budget κατα μέγιστο nodes απο τον παλιό πίνακα στον καινούργιο (μηχανισμός incremental rehash)
+	rehash_step(map, map->rehash_budget);
 
 	// Αν με την νέα εισαγωγή ξεπερνάμε το μέγιστο load factor, πρέπει να κάνουμε rehash.
-	// Στο load factor μετράμε και τα DELETED, γιατί και αυτά επηρρεάζουν τις αναζητήσεις.
-	float load_factor = (float)(map->size + map->deleted) / map->capacity;
-	if(load_factor > MAX_LOAD_FACTOR) {
-		// Εκκίνηση του incremental rehash
-		map->old_array = map->array;
-		map->old_capacity = map->capacity;
-		map->rehash_index = 0;
+	check_load(map, 0);
+}
 
-		// Διπλασιασμός της χωρητικότητας και δημιουργία νέου πίνακα
-		int new_capacity_index = 0;
-		while(prime_sizes[new_capacity_index] <= map->capacity) new_capacity_index++;
-		map->capacity = prime_sizes[new_capacity_index];
-		map->array = malloc(map->capacity * sizeof(struct map_node));
-		for(int i = 0; i < map->capacity; i++) map->array[i].state = EMPTY;
-
-		// Αντιγραφή δύο πρώτων στοιχείων από τον παλιό πίνακα
-		for(int i = 0; i < 2; i++) {
-			if(map->rehash_index < map->old_capacity) {
-				if(map->old_array[map->rehash_index].state == OCCUPIED) {
-					MapNode old_node = &map->old_array[map->rehash_index];
-					pos = map->hash_function(old_node->key) % map->capacity;
-					while(map->array[pos].state == OCCUPIED) {
-						pos = (pos + 1) % map->capacity;
-					}
-					map->array[pos] = *old_node;
-				}
-				map->rehash_index++;
-			} else {
-				free(map->old_array);
-				map->old_array = NULL;
-				map->old_capacity = 0;
-				map->rehash_index = 0;
-				break;
-			}
-		}
+void map_insert(Map map, Pointer key, Pointer value) {
+	map_insert_hashed(map, key, value, hash_key(map, key));
+}
+
+void map_insert_copy_string(Map map, const char* key, Pointer value) {
+	assert(!map->inline_storage && map->destroy_key == NULL);		// τα keys ανήκουν στο arena
+
+	uint hash = hash_key(map, (Pointer)key);
+	check_flooding(map);
+
+	bool already_in_map;
+	MapNode node = probe_insert(map, (Pointer)key, hash, &already_in_map);
+
+	// Αν το key υπάρχει ήδη, κρατάμε το αντίγραφο που έχουμε και αλλάζει μόνο το value
+	if (already_in_map) {
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+	} else {
+		occupy_node(map, node, arena_copy(map, key));
 	}
+	node->value = value;
+
+	rehash_step(map, map->rehash_budget);
+	check_load(map, 0);
+}
+
+// Η map_find_or_insert, με το hash code του key ήδη υπολογισμένο
+
+static MapNode find_or_insert(Map map, Pointer key, uint hash, bool* inserted) {
+	// Το incremental rehash προχωράει _πριν_ την αναζήτηση, ώστε ο κόμβος που επιστρέφουμε
+	// να μη μετακινηθεί πριν τον χρησιμοποιήσει ο caller.
+	rehash_step(map, map->rehash_budget);
+	check_flooding(map);
+
+	bool already_in_map;
+	MapNode node = probe_insert(map, key, hash, &already_in_map);
+
+	if (!already_in_map) {
+		// Αν η εισαγωγή θα ξεπεράσει το μέγιστο load factor, το rehash γίνεται πρώτα,
+		// και ψάχνουμε ξανά θέση, στον νέο πίνακα πλέον.
+		if (check_load(map, 1))
+			node = probe_insert(map, key, hash, &already_in_map);
+
+		occupy_node(map, node, key);
+		store_value(map, node, NULL);
+	}
+
+	if (inserted != NULL)
+		*inserted = !already_in_map;
+	return node;
+}
+
+MapNode map_find_or_insert(Map map, Pointer key, bool* inserted) {
+	return find_or_insert(map, key, hash_key(map, key), inserted);
+}
+
+void map_update(Map map, Pointer key, UpdateFunc update) {
+	map_update_hashed(map, key, update, hash_key(map, key));
+}
+
+void map_update_hashed(Map map, Pointer key, UpdateFunc update, uint hash) {
+	MapNode node = find_or_insert(map, key, hash, NULL);
+	map_node_set_value(map, node, update(node_value(map, node)));
 }
 
 // Διαργραφή απο το Hash Table του κλειδιού με τιμή key
 bool map_remove(Map map, Pointer key) {
-	MapNode node = map_find_node(map, key);
+	return map_remove_hashed(map, key, hash_key(map, key));
+}
+
+bool map_remove_hashed(Map map, Pointer key, uint hash) {
+	MapNode node = find_node(map, key, hash, true);
 	if(node == MAP_EOF) return false;
 
-	if(map->destroy_key != NULL) map->destroy_key(node->key);
-	if(map->destroy_value != NULL) map->destroy_value(node->value);
+	if(map->destroy_key != NULL) map->destroy_key(node_key(map, node));
+	if(map->destroy_value != NULL) map->destroy_value(node_value(map, node));
 
-	node->state = DELETED;
-	map->deleted++;
+	// Το αντίγραφο ενός key της map_insert_copy_string μένει στο arena μέχρι την επόμενη συμπύκνωση (εκτός αν
+	// ανήκει στο old_arena, που θα αποδεσμευτεί ούτως ή άλλως)
+	if (map->arena != NULL && (map->old_arena == NULL || in_array(map, map->array, map->capacity, node)))
+		map->arena_garbage += strlen(node->key) + 1;
+
+	// Τα DELETED του παλιού πίνακα δεν μετράνε στο load factor, ο πίνακας αυτός απλά αδειάζει
+	node->key = DELETED_KEY;
+	if (in_array(map, map->array, map->capacity, node))
+		map->deleted++;
 	map->size--;
 
+	// Το incremental rehash πρέπει να προχωράει και με τις διαγραφές, αλλιώς ένα shrink
+	// ακολουθούμενο μόνο από διαγραφές δε θα ολοκληρωνόταν ποτέ.
+	rehash_step(map, map->rehash_budget);
+
+	// Αν τα στοιχεία έπεσαν κάτω από το ελάχιστο load factor, μικραίνουμε τον πίνακα (αν δεν είναι ήδη στο ελάχιστο)
+	if (map->old_array == NULL && map->size < map->capacity * MIN_LOAD_FACTOR) {
+		int capacity = shrunk_capacity(map);
+		if (capacity < map->capacity) {
+			start_rehash(map, capacity);
+			map->stats.shrinks++;
+			rehash_step(map, map->rehash_budget);
+		}
+	}
+
 	return true;
 }
 
 // Αναζήτηση στο map, με σκοπό να επιστραφεί το value του κλειδιού που περνάμε σαν όρισμα.
 
 Pointer map_find(Map map, Pointer key) {
-	MapNode node = map_find_node(map, key);
-	if (node != MAP_EOF)
-		return node->value;
-	else
-		return NULL;
+	return map_find_hashed(map, key, hash_key(map, key));
+}
+
+Pointer map_find_hashed(Map map, Pointer key, uint hash) {
+	// Το incremental rehash προχωράει και με τις αναζητήσεις (εκτός αν ο χρήστης έχει ορίσει find_rehash_budget 0),
+	// ώστε ένα map που διαβάζεται κυρίως να μην ψάχνει για πάντα και στους δύο πίνακες. Γίνεται _πριν_ την
+	// αναζήτηση, γιατί με inline αποθήκευση το value που επιστρέφουμε είναι μέσα στον κόμβο, που δεν πρέπει να
+	// μετακινηθεί. Η map_find_node δεν το κάνει ποτέ, γιατί ο κόμβος που επιστρέφει θα μετακινούνταν.
+	rehash_step(map, map->find_rehash_budget);
+
+	MapNode node = find_node(map, key, hash, map->find_rehash_budget > 0);
+	return node != MAP_EOF ? node_value(map, node) : NULL;
+}
+
+
+// Υπολογίζει τα hash codes των count keys, και ζητάει από τον επεξεργαστή (prefetch) να φέρει στο cache
+// τις θέσεις στις οποίες κάνουν hash, σε όλους τους πίνακες. Ετσι οι προσβάσεις στη μνήμη όλων των keys
+// γίνονται παράλληλα, αντί για μία τη φορά (η καθεμία περιμένοντας την προηγούμενη).
+
+static void hash_and_prefetch(Map map, Pointer* keys, int count, uint* hashes) {
+	for (int i = 0; i < count; i++) {
+		hashes[i] = hash_key(map, keys[i]);
+
+		uint pos = home_pos(map, hashes[i], map->capacity);
+		__builtin_prefetch(node_at(map, map->array, pos));
+		if (map->old_array != NULL)
+			__builtin_prefetch(node_at(map, map->old_array, home_pos(map, hashes[i], map->old_capacity)));
+	}
 }
 
+void map_find_many(Map map, Pointer* keys, int n, Pointer* values) {
+	uint hashes[BATCH_SIZE];
+
+	// Όσο θα προχωρούσε το incremental rehash με n κλήσεις της map_find. Γίνεται από την αρχή, ώστε
+	// τα values που επιστρέφουμε (που με inline αποθήκευση είναι μέσα στους κόμβους) να μη μετακινηθούν.
+	// Το γινόμενο περιορίζεται στο INT_MAX, για πολύ μεγάλα n ή budget.
+	int budget = map->find_rehash_budget;
+	rehash_step(map, budget != 0 && n > INT_MAX / budget ? INT_MAX : n * budget);
+
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+		hash_and_prefetch(map, &keys[start], count, hashes);
+
+		// Οι θέσεις έχουν (σχεδόν) φτάσει στο cache. Ζητάμε και το key του κόμβου κάθε θέσης, που με
+		// load factor <= 0.5 είναι συνήθως το key που ψάχνουμε, ώστε να είναι έτοιμο για την compare.
+		for (int i = 0; i < count; i++) {
+			MapNode node = node_at(map, map->array, home_pos(map, hashes[i], map->capacity));
+			if (is_occupied(node))
+				__builtin_prefetch(node_key(map, node));
+		}
+
+		for (int i = 0; i < count; i++) {
+			MapNode node = find_node(map, keys[start + i], hashes[i], budget > 0);
+			values[start + i] = node != MAP_EOF ? node_value(map, node) : NULL;
+		}
+	}
+}
+
+void map_insert_many(Map map, Pointer* keys, Pointer* values, int n) {
+	uint hashes[BATCH_SIZE];
+
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+		hash_and_prefetch(map, &keys[start], count, hashes);
+
+		// Η εισαγωγή μπορεί να προκαλέσει rehash στη μέση της ομάδας, οπότε κάποια prefetch πάνε χαμένα,
+		// αλλά το αποτέλεσμα είναι πάντα σωστό, αφού η θέση υπολογίζεται ξανά.
+		for (int i = 0; i < count; i++)
+			map_insert_hashed(map, keys[start + i], values[start + i], hashes[i]);
+	}
+}
 
 DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
 	DestroyFunc old = map->destroy_key;
@@ -232,18 +901,36 @@ DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
 	return old;
 }
 
-// Απελευθέρωση μνήμης που δεσμεύει το map
-void map_destroy(Map map) {
-	for (int i = 0; i < map->capacity; i++) {
-		if (map->array[i].state == OCCUPIED) {
+// Καλεί τις destroy_key/destroy_value για όλους τους κόμβους ενός πίνακα
+
+static void destroy_nodes(Map map, MapNode array, int capacity) {
+	for (int i = 0; i < capacity; i++) {
+		MapNode node = node_at(map, array, i);
+		if (is_occupied(node)) {
 			if (map->destroy_key != NULL)
-				map->destroy_key(map->array[i].key);
+				map->destroy_key(node_key(map, node));
 			if (map->destroy_value != NULL)
-				map->destroy_value(map->array[i].value);
+				map->destroy_value(node_value(map, node));
 		}
 	}
+}
+
+// Απελευθέρωση μνήμης που δεσμεύει το map
+void map_destroy(Map map) {
+	// Περιμένουμε τυχόν thread που ετοιμάζει πίνακα, και αποδεσμεύουμε τον πίνακα αυτό
+	if (map->prealloc_pending)
+		free(take_array(map, map->prealloc_capacity));
+
+	// Τυχόν rehash σε εξέλιξη δεν ολοκληρώνεται: οι κόμβοι που δεν έχουν μεταφερθεί καταστρέφονται στον παλιό
+	// πίνακα, οπότε η map_destroy δεν κάνει hash ούτε συγκρίνει κανένα key.
+	destroy_nodes(map, map->array, map->capacity);
+	if (map->old_array != NULL)
+		destroy_nodes(map, map->old_array, map->old_capacity);
 
 	free(map->array);
+	free(map->old_array);
+	arena_free(map->arena);
+	arena_free(map->old_arena);
 	free(map);
 }
 
@@ -253,16 +940,16 @@ MapNode map_first(Map map) {
 	// Ελέγχουμε πρώτα τον νέο πίνακα
 	if (map->array != NULL) {
 		for (int i = 0; i < map->capacity; i++) {
-			if (map->array[i].state == OCCUPIED)
-				return &map->array[i];
+			if (is_occupied(node_at(map, map->array, i)))
+				return node_at(map, map->array, i);
 		}
 	}
 
 	// Αν δεν βρούμε στον νέο πίνακα, ελέγχουμε τον παλιό πίνακα αν βρίσκεται σε διαδικασία rehash
 	if (map->old_array != NULL) {
 		for (int i = 0; i < map->old_capacity; i++) {
-			if (map->old_array[i].state == OCCUPIED)
-				return &map->old_array[i];
+			if (is_occupied(node_at(map, map->old_array, i)))
+				return node_at(map, map->old_array, i);
 		}
 	}
 
@@ -271,18 +958,22 @@ MapNode map_first(Map map) {
 
 MapNode map_next(Map map, MapNode node) {
 	// Ελέγχουμε αν ο κόμβος ανήκει στον νέο πίνακα
-	if (node >= map->array && node < map->array + map->capacity) {
-		for (int i = node - map->array + 1; i < map->capacity; i++) {
-			if (map->array[i].state == OCCUPIED)
-				return &map->array[i];
+	int old_start = 0;
+	if (in_array(map, map->array, map->capacity, node)) {
+		for (int i = node_index(map, map->array, node) + 1; i < map->capacity; i++) {
+			if (is_occupied(node_at(map, map->array, i)))
+				return node_at(map, map->array, i);
 		}
+	} else {
+		// Ο κόμβος ανήκει στον παλιό πίνακα, συνεχίζουμε από τον επόμενο
+		old_start = node_index(map, map->old_array, node) + 1;
 	}
 
 	// Αν δεν βρούμε στον νέο πίνακα, ελέγχουμε τον παλιό πίνακα αν βρίσκεται σε διαδικασία rehash
-	if (map->old_array != NULL && (node >= map->old_array && node < map->old_array + map->old_capacity)) {
-		for (int i = node - map->old_array + 1; i < map->old_capacity; i++) {
-			if (map->old_array[i].state == OCCUPIED)
-				return &map->old_array[i];
+	if (map->old_array != NULL) {
+		for (int i = old_start; i < map->old_capacity; i++) {
+			if (is_occupied(node_at(map, map->old_array, i)))
+				return node_at(map, map->old_array, i);
 		}
 	}
 
@@ -290,63 +981,377 @@ MapNode map_next(Map map, MapNode node) {
 }
 
 Pointer map_node_key(Map map, MapNode node) {
-	return node->key;
+	return node_key(map, node);
 }
 
 Pointer map_node_value(Map map, MapNode node) {
-	return node->value;
+	return node_value(map, node);
+}
+
+void map_node_set_value(Map map, MapNode node, Pointer value) {
+	Pointer old_value = node_value(map, node);
+	if (old_value != value && old_value != NULL && map->destroy_value != NULL)
+		map->destroy_value(old_value);
+
+	store_value(map, node, value);
 }
 
 MapNode map_find_node(Map map, Pointer key) {
-	// Αναζήτηση στον τρέχοντα πίνακα
-	int count = 0;
-	for (uint pos = map->hash_function(key) % map->capacity;
-		map->array[pos].state != EMPTY;
-		pos = (pos + 1) % map->capacity) {
+	// Το hash code υπολογίζεται μία φορά, και για τους δύο πίνακες
+	return find_node(map, key, hash_key(map, key), false);
+}
+
+void map_set_sizing(Map map, MapSizing sizing) {
+	assert(map->size == 0 && map->old_array == NULL);		// μόνο σε κενό map, πριν από οποιαδήποτε εισαγωγή
+
+	map->sizing = sizing;
+	map->capacity = capacity_for(map, map->reserved, MAX_LOAD_FACTOR);		// διατηρούμε τυχόν map_reserve
+	map->deleted = 0;
+
+	free(map->array);
+	map->array = create_array(map->capacity, map->node_size);
+}
 
-		if (map->array[pos].state == OCCUPIED && map->compare(map->array[pos].key, key) == 0)
-			return &map->array[pos];
+void map_shrink_to_fit(Map map) {
+	// Ολοκληρώνουμε τυχόν rehash σε εξέλιξη, ώστε το deleted να αφορά όλα τα DELETED κελιά
+	rehash_step(map, map->old_capacity);
 
-		count++;
-		if (count == map->capacity)
+	// Το ρητό shrink ακυρώνει τυχόν προηγούμενο map_reserve
+	map->reserved = 0;
+	int capacity = shrunk_capacity(map);
+	if (capacity < map->capacity || map->deleted > 0) {
+		start_rehash(map, capacity < map->capacity ? capacity : map->capacity);
+		map->stats.shrinks++;
+
+		// Ο χρήστης μας ζήτησε ρητά να μικρύνουμε τον πίνακα, οπότε ολοκληρώνουμε αμέσως τη μεταφορά
+		rehash_step(map, map->old_capacity);
+	}
+}
+
+Map map_create_with_capacity(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value, int expected_entries) {
+	Map map = map_create(compare, destroy_key, destroy_value);
+	map_reserve(map, expected_entries);
+	return map;
+}
+
+Map map_create_inline(size_t key_size, size_t value_size, CompareFunc compare) {
+	assert(key_size > 0);
+
+	// Τα keys/values ανήκουν στον πίνακα, οπότε δεν υπάρχουν destroy_key/destroy_value
+	Map map = map_create(compare, NULL, NULL);
+	map->inline_storage = true;
+	map->key_size = key_size;
+	map->value_size = value_size;
+	map->value_offset = sizeof(uintptr_t) + ALIGN8(key_size);
+	map->node_size = map->value_offset + ALIGN8(value_size);
+
+	free(map->array);
+	map->array = create_array(map->capacity, map->node_size);
+	return map;
+}
+
+void map_grow(Map map, int expected_entries) {
+	int capacity = capacity_for(map, expected_entries, MAX_LOAD_FACTOR);
+	if (capacity <= map->capacity)
+		return;
+
+	if (map->size == 0 && map->old_array == NULL) {
+		// Κενό map (η συνηθισμένη περίπτωση, αμέσως μετά τη δημιουργία), απλά αντικαθιστούμε τον πίνακα
+		free(map->array);
+		map->capacity = capacity;
+		map->array = create_array(capacity, map->node_size);
+		map->deleted = 0;
+	} else {
+		// Μεταφέρουμε αμέσως όλα τα στοιχεία, ώστε οι επόμενες εισαγωγές να μην πληρώνουν καθόλου rehash
+		start_rehash(map, capacity);
+		map->stats.grows++;
+		rehash_step(map, map->old_capacity);
+	}
+}
+
+void map_reserve(Map map, int expected_entries) {
+	map->reserved = expected_entries;
+	map_grow(map, expected_entries);
+}
+
+void map_set_rehash_budget(Map map, int steps) {
+	assert(steps >= 0);
+	map->rehash_budget = steps;
+}
+
+void map_set_find_rehash_budget(Map map, int steps) {
+	assert(steps >= 0);
+	map->find_rehash_budget = steps;
+}
+
+bool map_rehash_step(Map map, int steps) {
+	rehash_step(map, steps);
+	return map->old_array == NULL;
+}
+
+void map_set_background_rehash(Map map, bool background) {
+	map->background = background;
+}
+
+MapStats map_stats(Map map) {
+	return map->stats;
+}
+
+// Παράλληλο χτίσιμο (map_build_parallel) //////////////////////////////////////////////////
+//
+// Ο πίνακας χωρίζεται σε threads διαδοχικές περιοχές, και κάθε key ανήκει στην περιοχή της θέσης στην οποία
+// κάνει hash (στις δυνάμεις του 2, αυτό είναι ένα πρόθεμα του hash code).
+// Οι περιοχές είναι ξένες μεταξύ τους, οπότε κάθε thread γεμίζει τη δική του χωρίς κανένα συγχρονισμό.
+// Το χτίσιμο γίνεται σε τρεις φάσεις, η καθεμία με threads threads:
+// 1. Κάθε thread υπολογίζει τα hash codes ενός τμήματος των keys, και μετράει πόσα ανήκουν σε κάθε περιοχή.
+// 2. Κάθε thread τοποθετεί τα indices του τμήματός του στο order, ταξινομημένα κατά περιοχή (counting sort,
+//    με τις θέσεις που προκύπτουν από τα αθροίσματα των μετρήσεων, και με τη σειρά των keys).
+// 3. Κάθε thread εισάγει τα keys της περιοχής του. Ένα key που δε χωράει μέχρι το τέλος της περιοχής (το linear
+//    probing θα συνέχιζε στην επόμενη) μένει στο overflow, και εισάγεται κανονικά μετά το τέλος των threads.
+
+struct build {
+	Map map;
+	Pointer* keys;
+	Pointer* values;
+	int n;
+	int threads;
+	uint* hashes;			// Το hash code του keys[i]
+	int* order;				// Τα indices των keys, ταξινομημένα κατά περιοχή
+	int* counts;			// counts[t * threads + r]: πόσα keys του τμήματος t ανήκουν στην περιοχή r (μετά τη φάση 1:
+							// η θέση του order από την οποία ξεκινάνε)
+	int* region_start;		// Η θέση του order στην οποία ξεκινάει κάθε περιοχή (threads + 1 τιμές)
+};
+
+struct build_thread {
+	struct build* build;
+	int id;
+	int inserted;			// Πόσα νέα keys εισήχθησαν στην περιοχή
+	int longest_probe;
+	int* overflow;			// Τα indices των keys που δε χώρεσαν στην περιοχή (με τη σειρά τους)
+	int overflow_size;
+	int overflow_capacity;
+};
+
+// Η πρώτη θέση του πίνακα που ανήκει στην περιοχή region. Η θέση pos ανήκει στην περιοχή pos * threads / capacity.
+
+static inline uint region_first_pos(int region, int threads, int capacity) {
+	return ((uint64_t)region * capacity + threads - 1) / threads;
+}
+
+static inline int region_of(struct build* build, uint hash) {
+	return (uint64_t)home_pos(build->map, hash, build->map->capacity) * build->threads / build->map->capacity;
+}
+
+// Το τμήμα των keys που επεξεργάζεται το thread id στις φάσεις 1 και 2 είναι [first, last)
+
+static void build_chunk(struct build* build, int id, int* first, int* last) {
+	*first = (int64_t)build->n * id / build->threads;
+	*last = (int64_t)build->n * (id + 1) / build->threads;
+}
+
+static void* build_hash_main(void* arg) {
+	struct build* build = ((struct build_thread*)arg)->build;
+	int id = ((struct build_thread*)arg)->id;
+	int* counts = &build->counts[id * build->threads];
+
+	int first, last;
+	build_chunk(build, id, &first, &last);
+	for (int i = first; i < last; i++) {
+		build->hashes[i] = hash_key(build->map, build->keys[i]);
+		counts[region_of(build, build->hashes[i])]++;
+	}
+	return NULL;
+}
+
+static void* build_scatter_main(void* arg) {
+	struct build* build = ((struct build_thread*)arg)->build;
+	int id = ((struct build_thread*)arg)->id;
+	int* next = &build->counts[id * build->threads];
+
+	int first, last;
+	build_chunk(build, id, &first, &last);
+	for (int i = first; i < last; i++)
+		build->order[next[region_of(build, build->hashes[i])]++] = i;
+	return NULL;
+}
+
+static void* build_insert_main(void* arg) {
+	struct build_thread* thread = arg;
+	struct build* build = thread->build;
+	Map map = build->map;
+	uint end = region_first_pos(thread->id + 1, build->threads, map->capacity);
+
+	for (int j = build->region_start[thread->id]; j < build->region_start[thread->id + 1]; j++) {
+		int i = build->order[j];
+		Pointer key = build->keys[i];
+		uint hash = build->hashes[i];
+
+		// Linear probing μέχρι το τέλος της περιοχής (χωρίς να γυρίσουμε στην αρχή του πίνακα)
+		MapNode node = NULL;
+		uint pos = home_pos(map, hash, map->capacity);
+		int probes = 0;
+		for (; pos < end; pos++, probes++) {
+			MapNode current = node_at(map, map->array, pos);
+			if (current->key == EMPTY_KEY || has_key(map, current, key)) {
+				node = current;
+				break;
+			}
+		}
+		if (probes > thread->longest_probe)
+			thread->longest_probe = probes;
+
+		if (node == NULL) {
+			if (thread->overflow_size == thread->overflow_capacity) {
+				thread->overflow_capacity = thread->overflow_capacity == 0 ? 64 : 2 * thread->overflow_capacity;
+				thread->overflow = realloc(thread->overflow, thread->overflow_capacity * sizeof(int));
+			}
+			thread->overflow[thread->overflow_size++] = i;
+			continue;
+		}
+
+		// Όπως στη map_insert_hashed, αν το key υπάρχει ήδη αντικαθιστούμε το ζευγάρι
+		if (node->key == EMPTY_KEY) {
+			thread->inserted++;
+		} else {
+			if (node_key(map, node) != key && map->destroy_key != NULL)
+				map->destroy_key(node_key(map, node));
+			if (node_value(map, node) != build->values[i] && map->destroy_value != NULL)
+				map->destroy_value(node_value(map, node));
+		}
+		store_key(map, node, key);
+		store_value(map, node, build->values[i]);
+	}
+	return NULL;
+}
+
+// Εκτελεί τη main σε threads threads (το τελευταίο στο τρέχον thread), με ορίσματα τα args[0..threads-1]
+
+static void build_run(void* (*main)(void*), struct build_thread* args, int threads) {
+	pthread_t thread_ids[threads];
+	int created = 0;
+	for (; created < threads - 1; created++)
+		if (pthread_create(&thread_ids[created], NULL, main, &args[created]) != 0)
 			break;
+
+	// Αν κάποιο thread δεν μπόρεσε να δημιουργηθεί, τη δουλειά του την κάνουμε εμείς
+	for (int i = created; i < threads; i++)
+		main(&args[i]);
+	for (int i = 0; i < created; i++)
+		pthread_join(thread_ids[i], NULL);
+}
+
+void map_build_parallel(Map map, Pointer* keys, Pointer* values, int n, int threads) {
+	map_grow(map, map->size + n);
+
+	// Το παράλληλο χτίσιμο γίνεται μόνο σε κενό map, χωρίς rehash σε εξέλιξη
+	if (threads > map->capacity / BUILD_MIN_REGION)
+		threads = map->capacity / BUILD_MIN_REGION;
+	if (threads <= 1 || map->size != 0 || map->old_array != NULL) {
+		map_insert_many(map, keys, values, n);
+		return;
 	}
 
-	// Αν το στοιχείο δεν βρέθηκε, αναζήτηση στον παλιό πίνακα
-	if(map->old_array != NULL) {
-		count = 0;
-		for(uint pos = map->hash_function(key) % map->old_capacity;
-			map->old_array[pos].state != EMPTY;
-			pos = (pos + 1) % map->old_capacity) {
+	struct build build = {
+		.map = map,
+		.keys = keys,
+		.values = values,
+		.n = n,
+		.threads = threads,
+		.hashes = malloc(n * sizeof(uint)),
+		.order = malloc(n * sizeof(int)),
+		.counts = calloc(threads * threads, sizeof(int)),
+		.region_start = malloc((threads + 1) * sizeof(int)),
+	};
+	struct build_thread* args = calloc(threads, sizeof(*args));
+	for (int t = 0; t < threads; t++) {
+		args[t].build = &build;
+		args[t].id = t;
+	}
 
-			if(map->old_array[pos].state == OCCUPIED && map->compare(map->old_array[pos].key, key) == 0)
-				return &map->old_array[pos];
+	build_run(build_hash_main, args, threads);
 
-			count++;
-			if(count == map->old_capacity) break;
+	// Η περιοχή r του order περιέχει πρώτα τα keys της από το τμήμα 0, μετά από το τμήμα 1, κλπ,
+	// ώστε διπλά keys να εισάγονται με τη σειρά που δόθηκαν
+	int position = 0;
+	for (int r = 0; r < threads; r++) {
+		build.region_start[r] = position;
+		for (int t = 0; t < threads; t++) {
+			int count = build.counts[t * threads + r];
+			build.counts[t * threads + r] = position;
+			position += count;
 		}
 	}
+	build.region_start[threads] = position;
 
-	return MAP_EOF;
+	build_run(build_scatter_main, args, threads);
+	build_run(build_insert_main, args, threads);
+
+	for (int t = 0; t < threads; t++) {
+		map->size += args[t].inserted;
+		if (args[t].longest_probe > map->stats.longest_probe)
+			map->stats.longest_probe = args[t].longest_probe;
+	}
+
+	// Τα keys που δε χώρεσαν στην περιοχή τους. Όλα τα αντίγραφα ενός key ανήκουν στην ίδια περιοχή,
+	// οπότε και εδώ εισάγονται με τη σειρά που δόθηκαν.
+	for (int t = 0; t < threads; t++) {
+		for (int j = 0; j < args[t].overflow_size; j++) {
+			int i = args[t].overflow[j];
+			map_insert_hashed(map, keys[i], values[i], build.hashes[i]);
+		}
+		free(args[t].overflow);
+	}
+
+	free(args);
+	free(build.hashes);
+	free(build.order);
+	free(build.counts);
+	free(build.region_start);
 }
 
-// Αρχικοποίηση της συνάρτησης κατακερματισμού του συγκεκριμένου map.
-void map_set_hash_function(Map map, HashFunc func) {
-	map->hash_function = func;
+// Συναρτήσεις κατακερματισμού ////////////////////////////////////////////////////////////
+//
+// Οι hash_string, hash_int και hash_pointer (και οι seeded εκδοχές τους) υλοποιούνται στο κοινό
+// HashFunctions/hash_functions.c.
+
+uint map_hash(Map map, Pointer key) {
+	return hash_key(map, key);
 }
 
-uint hash_string(Pointer value) {
-	// djb2 hash function, απλή, γρήγορη, και σε γενικές γραμμές αποδοτική
-    uint hash = 5381;
-    for (char* s = value; *s != '\0'; s++)
-		hash = (hash << 5) + hash + *s;			// hash = (hash * 33) + *s. Το foo << 5 είναι γρηγορότερη εκδοχή του foo * 32.
-    return hash;
+// Χτίζει τον πίνακα από την αρχή, στο ίδιο μέγεθος, μετά από αλλαγή του salt ή του seed
+
+static void rebuild(Map map) {
+	// Ολοκλήρωση τυχόν incremental rehash, ώστε όλα τα στοιχεία να είναι στον τρέχοντα πίνακα
+	rehash_step(map, map->old_capacity);
+
+	MapNode old_array = map->array;
+	map->array = create_array(map->capacity, map->node_size);
+	map->deleted = 0;
+	map->stats.longest_probe = 0;
+
+	for (int i = 0; i < map->capacity; i++) {
+		MapNode node = node_at(map, old_array, i);
+		if (is_occupied(node))
+			place_node(map, node, hash_key(map, node_key(map, node)));
+	}
+	free(old_array);
 }
 
-uint hash_int(Pointer value) {
-	return *(int*)value;
+// Αρχικοποίηση της συνάρτησης κατακερματισμού του συγκεκριμένου map.
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+
+	// Για τις συναρτήσεις της βιβλιοθήκης χρησιμοποιούμε απευθείας τις seeded εκδοχές τους.
+	// Οι συναρτήσεις του χρήστη χρησιμοποιούνται όπως είναι (δεν δέχονται seed).
+	map->seeded_hash =
+		func == hash_string ? hash_string_seeded :
+		func == hash_int ? hash_int_seeded :
+		func == hash_pointer ? hash_pointer_seeded :
+		NULL;
 }
 
-uint hash_pointer(Pointer value) {
-	return (size_t)value;				// cast σε sizt_t, που έχει το ίδιο μήκος με έναν pointer
+void map_set_hash_seed(Map map, uint64_t seed) {
+	map->seed = seed;
+	if (map->size > 0 && map->seeded_hash != NULL)
+		rebuild(map);
 }
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT ShardedMap μέσω πολλών ADT Map (UsingHashTable)
+//
+// Κάθε shard είναι ένα ανεξάρτητο Map, με δικό του lock (αν το map είναι locked), σε δικό του
+// cache line. Το shard ενός key επιλέγεται από τα υψηλά bits του (ανακατεμένου) hash code του,
+// οπότε shards με τον ίδιο αριθμό σε διαφορετικά ShardedMap περιέχουν πάντα τα ίδια keys, και
+// η συγχώνευση γίνεται shard προς shard.
+//
+// Το hash code υπολογίζεται μία φορά (map_hash), και χρησιμοποιείται τόσο για την επιλογή του shard όσο και
+// στις map_*_hashed του shard. Αυτό είναι σωστό γιατί όλα τα shards έχουν την ίδια hash_function και το ίδιο
+// seed (αυτό που επιλέγεται μία φορά για όλο το πρόγραμμα, αφού δεν καλούμε ποτέ map_set_hash_seed), ενώ το
+// salt κάθε Map μετά από hash flooding αλλάζει μόνο τις θέσεις του πίνακα, όχι τα hash codes.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "ADTShardedMap.h"
+
+
+// Ένα shard
+struct shard {
+	_Alignas(64) Map map;
+	pthread_mutex_t lock;		// Χρησιμοποιείται μόνο αν το map είναι locked
+};
+
+typedef struct shard* Shard;
+
+// Δομή του ShardedMap
+struct sharded_map {
+	Shard shards;
+	int shard_bits;				// log2 του πλήθους των shards
+	int shard_count;
+	bool locked;
+	CompareFunc compare;		// Οι παράμετροι της sharded_map_create, για τη δημιουργία (κενών) shards
+	HashFunc hash_function;
+	DestroyFunc destroy_key;
+	DestroyFunc destroy_value;
+	Map hasher;					// Κενό Map με την ίδια hash_function, που χρησιμοποιείται μόνο για τη map_hash
+};
+
+
+// Τα bits του hash code ανακατεύονται (finalizer του MurmurHash3) πριν επιλεγεί το shard, ώστε πχ
+// το hash_int μικρών αριθμών να μην καταλήγει όλο στο πρώτο shard.
+static inline uint mix_hash(uint hash) {
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+// Το hash code του key, όπως το υπολογίζουν τα Map των shards. Τα Map των shards αντικαθίστανται κατά τη
+// συγχώνευση, οπότε χρησιμοποιούμε το hasher, που δεν αλλάζει ποτέ και μπορεί να διαβάζεται χωρίς lock.
+static inline uint hash_of(ShardedMap map, Pointer key) {
+	return map_hash(map->hasher, key);
+}
+
+static inline Shard shard_of(ShardedMap map, uint hash) {
+	uint mixed = mix_hash(hash);
+	return &map->shards[map->shard_bits == 0 ? 0 : mixed >> (32 - map->shard_bits)];
+}
+
+static inline void lock_shard(ShardedMap map, Shard shard) {
+	if (map->locked)
+		pthread_mutex_lock(&shard->lock);
+}
+
+static inline void unlock_shard(ShardedMap map, Shard shard) {
+	if (map->locked)
+		pthread_mutex_unlock(&shard->lock);
+}
+
+static Map create_shard_map(ShardedMap map) {
+	Map shard_map = map_create(map->compare, map->destroy_key, map->destroy_value);
+	map_set_hash_function(shard_map, map->hash_function);
+	return shard_map;
+}
+
+// Μεταφέρει όλα τα στοιχεία του from (shard του source) στο to, και αδειάζει το from
+
+static void move_entries(ShardedMap source, Shard from, Map to, MergeFunc merge) {
+	// Τα keys/values του source που δεν μεταφέρθηκαν (διπλά keys) καταστρέφονται αμέσως. Η διάσχιση του from
+	// δεν ξαναδιαβάζει keys που έχουμε ήδη επισκεφτεί, και η map_destroy του from (χωρίς destroy συναρτήσεις)
+	// δεν κάνει hash ούτε συγκρίνει keys, οπότε κανένα κατεστραμμένο key δε χρησιμοποιείται ξανά.
+	for (MapNode node = map_first(from->map); node != MAP_EOF; node = map_next(from->map, node)) {
+		Pointer key = map_node_key(from->map, node);
+		Pointer value = map_node_value(from->map, node);
+
+		bool inserted;
+		MapNode target = map_find_or_insert(to, key, &inserted);
+		if (inserted) {
+			map_node_set_value(to, target, value);
+			continue;
+		}
+
+		// Το key υπάρχει ήδη στο to, που κρατάει το δικό του key
+		Pointer merged = merge != NULL ? merge(map_node_value(to, target), value) : value;
+		map_node_set_value(to, target, merged);
+
+		if (source->destroy_key != NULL)
+			source->destroy_key(key);
+		if (merged != value && source->destroy_value != NULL)
+			source->destroy_value(value);
+	}
+
+	// Τα keys/values ανήκουν πλέον στο to (ή έχουν καταστραφεί), οπότε το from καταστρέφεται χωρίς τις destroy συναρτήσεις
+	map_set_destroy_key(from->map, NULL);
+	map_set_destroy_value(from->map, NULL);
+	map_destroy(from->map);
+	from->map = create_shard_map(source);
+}
+
+ShardedMap sharded_map_create(int shards, bool locked, CompareFunc compare, HashFunc hash_function,
+	DestroyFunc destroy_key, DestroyFunc destroy_value) {
+
+	ShardedMap map = malloc(sizeof(*map));
+	map->shard_bits = 0;
+	while ((1 << map->shard_bits) < shards)
+		map->shard_bits++;
+	map->shard_count = 1 << map->shard_bits;
+	map->locked = locked;
+	map->compare = compare;
+	map->hash_function = hash_function;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	map->hasher = create_shard_map(map);
+	map->shards = aligned_alloc(64, map->shard_count * sizeof(struct shard));
+	for (int i = 0; i < map->shard_count; i++) {
+		map->shards[i].map = create_shard_map(map);
+		pthread_mutex_init(&map->shards[i].lock, NULL);
+	}
+
+	return map;
+}
+
+int sharded_map_size(ShardedMap map) {
+	int size = 0;
+	for (int i = 0; i < map->shard_count; i++) {
+		lock_shard(map, &map->shards[i]);
+		size += map_size(map->shards[i].map);
+		unlock_shard(map, &map->shards[i]);
+	}
+	return size;
+}
+
+// Το hashing γίνεται πριν πάρουμε το lock, ώστε να μην καθυστερεί τα άλλα threads του shard
+
+void sharded_map_insert(ShardedMap map, Pointer key, Pointer value) {
+	uint hash = hash_of(map, key);
+	Shard shard = shard_of(map, hash);
+	lock_shard(map, shard);
+	map_insert_hashed(shard->map, key, value, hash);
+	unlock_shard(map, shard);
+}
+
+bool sharded_map_remove(ShardedMap map, Pointer key) {
+	uint hash = hash_of(map, key);
+	Shard shard = shard_of(map, hash);
+	lock_shard(map, shard);
+	bool removed = map_remove_hashed(shard->map, key, hash);
+	unlock_shard(map, shard);
+	return removed;
+}
+
+Pointer sharded_map_find(ShardedMap map, Pointer key) {
+	// Και η map_find χρειάζεται το lock, αφού άλλα threads μπορεί να τροποποιούν το ίδιο shard (και η ίδια
+	// μεταφέρει κελιά του incremental rehash)
+	uint hash = hash_of(map, key);
+	Shard shard = shard_of(map, hash);
+	lock_shard(map, shard);
+	Pointer value = map_find_hashed(shard->map, key, hash);
+	unlock_shard(map, shard);
+	return value;
+}
+
+void sharded_map_update(ShardedMap map, Pointer key, UpdateFunc update) {
+	uint hash = hash_of(map, key);
+	Shard shard = shard_of(map, hash);
+	lock_shard(map, shard);
+	map_update_hashed(shard->map, key, update, hash);
+	unlock_shard(map, shard);
+}
+
+void sharded_map_merge(ShardedMap target, ShardedMap source, MergeFunc merge) {
+	assert(target->shard_count == source->shard_count);
+
+	// Κάθε source ξεκινάει από διαφορετικό shard (ανάλογα με τη διεύθυνσή του), ώστε threads που συγχωνεύουν
+	// ταυτόχρονα στο ίδιο target να μη ζητάνε όλα τα ίδια locks με την ίδια σειρά
+	int start = ((uintptr_t)source / sizeof(*source)) % source->shard_count;
+	for (int n = 0; n < source->shard_count; n++) {
+		int i = (start + n) % source->shard_count;
+		lock_shard(source, &source->shards[i]);
+		lock_shard(target, &target->shards[i]);
+
+		if (map_size(target->shards[i].map) == 0)
+			map_grow(target->shards[i].map, map_size(source->shards[i].map));
+		move_entries(source, &source->shards[i], target->shards[i].map, merge);
+
+		unlock_shard(target, &target->shards[i]);
+		unlock_shard(source, &source->shards[i]);
+	}
+}
+
+void sharded_map_merge_into(ShardedMap source, Map target, MergeFunc merge) {
+	// Αν το target δεν είναι κενό, δεν ξέρουμε πόσα keys είναι κοινά, οπότε δεσμεύουμε χώρο μόνο για το κενό target
+	if (map_size(target) == 0)
+		map_grow(target, sharded_map_size(source));
+
+	for (int i = 0; i < source->shard_count; i++) {
+		lock_shard(source, &source->shards[i]);
+		move_entries(source, &source->shards[i], target, merge);
+		unlock_shard(source, &source->shards[i]);
+	}
+}
+
+void sharded_map_destroy(ShardedMap map) {
+	for (int i = 0; i < map->shard_count; i++) {
+		map_destroy(map->shards[i].map);
+		pthread_mutex_destroy(&map->shards[i].lock);
+	}
+	map_destroy(map->hasher);
+	free(map->shards);
+	free(map);
+}
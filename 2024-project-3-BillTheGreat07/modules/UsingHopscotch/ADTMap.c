@@ -0,0 +1,407 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Hopscotch hashing
+//
+// Κάθε key βρίσκεται πάντα μέσα στη "γειτονιά" της θέσης στην οποία κάνει hash (home),
+// δηλαδή σε μία από τις NEIGHBORHOOD θέσεις που ξεκινούν από αυτή. Ο κόμβος της θέσης home
+// κρατάει ένα bitmap (hop) με τις θέσεις της γειτονιάς που περιέχουν keys του, οπότε η αναζήτηση
+// εξετάζει μόνο αυτούς τους κόμβους, συνήθως σε μία ή δύο cache lines, ανεξάρτητα από το load factor
+// (και, αν δεν είναι άδειο, το stash, βλ. παρακάτω).
+//
+// Η εισαγωγή βρίσκει την πρώτη κενή θέση (με linear probing) και, όσο αυτή είναι έξω από τη
+// γειτονιά, μετακινεί σε αυτή κάποιον προηγούμενο κόμβο που παραμένει στη δική του γειτονιά,
+// φέρνοντας την κενή θέση πιο κοντά. Αν δε γίνεται, διπλασιάζουμε τον πίνακα. Αν όμως ο πίνακας είναι
+// ακόμα αραιός, η γειτονιά έχει γεμίσει με keys που κάνουν hash στις ίδιες θέσεις, οπότε ο διπλασιασμός
+// δε θα βοηθούσε, και το key μπαίνει στο stash του map, που διατρέχεται σειριακά (μόνο όταν δεν είναι άδειο).
+// Το stash έχει το πολύ STASH_SIZE κόμβους: όταν γεμίσει, οι θέσεις των keys ανακατεύονται με ένα νέο τυχαίο
+// salt (μία φορά για κάθε μέγεθος πίνακα) και ο πίνακας ξαναχτίζεται, ώστε keys επιλεγμένα να συγκρούονται
+// στις ίδιες θέσεις να σκορπίσουν. Μόνο keys με ακριβώς το ίδιο hash code (πχ περισσότερα από NEIGHBORHOOD keys
+// με το ίδιο hash code), που κανένα salt δεν μπορεί να χωρίσει, μπορούν να μεγαλώσουν το stash πέρα από αυτό.
+//
+// Η διαγραφή απλά αδειάζει τον κόμβο (δεν χρειάζονται DELETED κόμβοι). Κάθε λειτουργία αγγίζει μόνο τη
+// γειτονιά ενός key και (αν δεν είναι άδειο) το stash, που είναι κοινό για όλο τον πίνακα, οπότε κλείδωμα ανά
+// περιοχή του πίνακα θα χρειαζόταν και ξεχωριστό lock για το stash.
+//
+// Λόγω των μετακινήσεων, μετά από map_insert οι MapNode που έχουμε κρατήσει δεν είναι έγκυροι.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "ADTMap.h"
+
+
+// Το μέγεθος του πίνακα είναι δύναμη του 2, και η θέση κάθε key υπολογίζεται με Fibonacci hashing
+#define INITIAL_CAPACITY 64
+#define FIBONACCI_MULTIPLIER 2654435769u
+
+// Μέγεθος της γειτονιάς (όσα bits έχει το hop bitmap)
+#define NEIGHBORHOOD 32
+
+// Πόσο μακριά από τη θέση home αναζητούμε κενή θέση κατά την εισαγωγή, πριν μεγαλώσουμε τον πίνακα
+#define MAX_PROBE 1024
+
+// Με γειτονιά 32 θέσεων, οι εισαγωγές σπάνια αποτυγχάνουν μέχρι περίπου 90%
+#define MAX_LOAD_FACTOR 0.85
+
+// Αν μια εισαγωγή αποτύχει με τον πίνακα γεμάτο λιγότερο από αυτό, το key μπαίνει στο stash αντί να μεγαλώσει ο πίνακας
+#define MIN_RESIZE_LOAD_FACTOR 0.5
+
+// Πόσοι κόμβοι χωράνε στο stash πριν αλλάξουμε το salt (εκτός από keys με το ίδιο hash code, βλ. παραπάνω)
+#define STASH_SIZE 8
+
+// Όπως στο UsingHashTable, οι κενοί κόμβοι έχουν ως key τη διεύθυνση του empty_sentinel, που δεν μπορεί να
+// είναι key του χρήστη.
+static char empty_sentinel;
+#define EMPTY_KEY ((Pointer)&empty_sentinel)
+
+// Δομή του κάθε κόμβου. Το hash code χωράει στο padding μετά το hop (ο κόμβος μένει 24 bytes), και χρησιμοποιείται
+// ώστε η compare να καλείται μόνο για κόμβους με το ίδιο hash code, και το resize να μη χρειάζεται την hash_function.
+struct map_node {
+	Pointer key;			// Το key (ή EMPTY_KEY)
+	Pointer value;
+	uint32_t hop;			// Το bit i είναι 1 αν η θέση (αυτή + i) περιέχει key που κάνει hash σε αυτή τη θέση
+	uint32_t hash;			// Το hash code του key
+};
+
+// Δομή του Map
+struct map {
+	MapNode array;				// Ο πίνακας του hash table
+	int capacity;				// Πόσο χώρο έχουμε δεσμεύσει (δύναμη του 2)
+	int shift;					// 32 - log2(capacity), για τον υπολογισμό της θέσης home
+	int size;					// Πόσα στοιχεία έχουμε προσθέσει (μαζί με αυτά του stash)
+	MapNode stash;				// Κόμβοι που δεν χώρεσαν στη γειτονιά τους
+	int stash_size;
+	int stash_capacity;
+	uint64_t salt;				// Αν δεν είναι 0, οι θέσεις υπολογίζονται από το hash code ανακατεμένο με το salt
+	int salt_capacity;			// Το capacity στο οποίο άλλαξε τελευταία φορά το salt
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+static inline uint64_t mix64(uint64_t x) {
+	// Ο finalizer του splitmix64
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+// Η θέση στην οποία κάνει hash ένα hash code (αφού ανακατευτεί με το salt, αν υπάρχει)
+static inline uint home_pos(Map map, uint hash) {
+	if (map->salt != 0)
+		hash = mix64(hash ^ map->salt);
+	return (hash * FIBONACCI_MULTIPLIER) >> map->shift;
+}
+
+// Η θέση pos + offset, γυρνώντας στην αρχή όταν φτάσουμε στο τέλος του πίνακα
+static inline uint pos_at(Map map, uint pos, uint offset) {
+	return (pos + offset) & (map->capacity - 1);
+}
+
+// Δεσμεύει έναν κενό πίνακα μεγέθους capacity
+static void allocate_array(Map map, int capacity) {
+	map->capacity = capacity;
+	map->shift = 32 - __builtin_ctz(capacity);
+	map->array = malloc(capacity * sizeof(struct map_node));
+	for (int i = 0; i < capacity; i++) {
+		map->array[i].key = EMPTY_KEY;
+		map->array[i].hop = 0;
+	}
+}
+
+static inline bool in_stash(Map map, MapNode node) {
+	return node >= map->stash && node < map->stash + map->stash_capacity;
+}
+
+// Προσθέτει έναν κόμβο στο stash, μεγαλώνοντάς το αν χρειάζεται
+
+static void stash_push(Map map, Pointer key, Pointer value, uint hash) {
+	if (map->stash_size == map->stash_capacity) {
+		map->stash_capacity = map->stash_capacity == 0 ? STASH_SIZE : 2 * map->stash_capacity;
+		map->stash = realloc(map->stash, map->stash_capacity * sizeof(struct map_node));
+	}
+	map->stash[map->stash_size].key = key;
+	map->stash[map->stash_size].value = value;
+	map->stash[map->stash_size].hop = 0;
+	map->stash[map->stash_size].hash = hash;
+	map->stash_size++;
+}
+
+// Αναζητά τον κόμβο με κλειδί key, του οποίου το hash code είναι hash. Εξετάζονται μόνο οι θέσεις του hop bitmap
+// (και το stash, αν δεν είναι άδειο).
+
+static MapNode find_node(Map map, Pointer key, uint hash) {
+	uint home = home_pos(map, hash);
+	for (uint32_t hop = map->array[home].hop; hop != 0; hop &= hop - 1) {
+		MapNode node = &map->array[pos_at(map, home, __builtin_ctz(hop))];
+		if (node->hash == hash && map->compare(node->key, key) == 0)
+			return node;
+	}
+
+	for (int i = 0; i < map->stash_size; i++)
+		if (map->stash[i].hash == hash && map->compare(map->stash[i].key, key) == 0)
+			return &map->stash[i];
+
+	return MAP_EOF;
+}
+
+// Τοποθετεί το key με hash code hash, που σίγουρα δεν υπάρχει στο map.
+// Επιστρέφει false αν δεν μπορεί να βρεθεί θέση μέσα στη γειτονιά του (οπότε πρέπει να μεγαλώσει ο πίνακας).
+
+static bool place_node(Map map, Pointer key, Pointer value, uint hash) {
+	// Η πρώτη κενή θέση μετά το home, σε απόσταση distance
+	uint home = home_pos(map, hash);
+	uint distance = 0;
+	while (map->array[pos_at(map, home, distance)].key != EMPTY_KEY)
+		if (++distance == MAX_PROBE || distance == (uint)map->capacity)
+			return false;
+
+	// Όσο η κενή θέση είναι έξω από τη γειτονιά, βρίσκουμε την πιο απομακρυσμένη θέση bucket πριν από αυτήν
+	// (ώστε να κερδίσουμε όσο περισσότερο γίνεται) με κάποιο key στη γειτονιά της και πριν από την κενή θέση.
+	// Το key αυτό μεταφέρεται στην κενή θέση (παραμένοντας στη γειτονιά του), και η θέση του γίνεται η νέα κενή.
+	while (distance >= NEIGHBORHOOD) {
+		uint free_pos = pos_at(map, home, distance);
+		uint moved = 0;
+
+		for (uint back = NEIGHBORHOOD - 1; back > 0 && moved == 0; back--) {
+			MapNode bucket = &map->array[pos_at(map, free_pos, -back)];
+
+			// Τα keys του bucket σε θέσεις πριν την κενή (offset < back). Διαλέγουμε το πρώτο.
+			uint32_t candidates = bucket->hop & (((uint32_t)1 << back) - 1);
+			if (candidates == 0)
+				continue;
+
+			uint offset = __builtin_ctz(candidates);
+			MapNode from = &map->array[pos_at(map, free_pos, offset - back)];
+			MapNode to = &map->array[free_pos];
+			to->key = from->key;
+			to->value = from->value;
+			to->hash = from->hash;
+			from->key = EMPTY_KEY;
+			bucket->hop = (bucket->hop & ~((uint32_t)1 << offset)) | (uint32_t)1 << back;
+
+			moved = back - offset;
+		}
+
+		if (moved == 0)
+			return false;
+		distance -= moved;
+	}
+
+	MapNode node = &map->array[pos_at(map, home, distance)];
+	node->key = key;
+	node->value = value;
+	node->hash = hash;
+	map->array[home].hop |= (uint32_t)1 << distance;
+	return true;
+}
+
+// Αλλάζει το μέγεθος του πίνακα σε new_capacity, μεταφέροντας όλους τους κόμβους (και αυτούς του stash,
+// που μπορεί πλέον να χωράνε στη γειτονιά τους) με τα αποθηκευμένα hash codes τους. Όσοι δε χωράνε στον
+// νέο πίνακα μπαίνουν στο stash.
+
+static void resize(Map map, int new_capacity) {
+	MapNode old_array = map->array;
+	int old_capacity = map->capacity;
+	MapNode old_stash = map->stash;
+	int old_stash_size = map->stash_size;
+
+	allocate_array(map, new_capacity);
+	map->stash = NULL;
+	map->stash_size = 0;
+	map->stash_capacity = 0;
+
+	for (int i = 0; i < old_capacity + old_stash_size; i++) {
+		MapNode node = i < old_capacity ? &old_array[i] : &old_stash[i - old_capacity];
+		if (node->key != EMPTY_KEY && !place_node(map, node->key, node->value, node->hash))
+			stash_push(map, node->key, node->value, node->hash);
+	}
+
+	free(old_array);
+	free(old_stash);
+}
+
+// Ξαναχτίζει τον πίνακα στο ίδιο μέγεθος με νέο τυχαίο salt, ώστε να αλλάξουν οι θέσεις όλων των keys
+
+static void reseed(Map map) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	map->salt = mix64((uintptr_t)map ^ map->salt ^ mix64(now.tv_nsec)) | 1;		// ποτέ 0
+	map->salt_capacity = map->capacity;
+	resize(map, map->capacity);
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+	allocate_array(map, INITIAL_CAPACITY);
+
+	map->size = 0;
+	map->stash = NULL;
+	map->stash_size = 0;
+	map->stash_capacity = 0;
+	map->salt = 0;
+	map->salt_capacity = 0;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint hash = map->hash_function(key);
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value
+	MapNode node = find_node(map, key, hash);
+	if (node != MAP_EOF) {
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	if (map->size + 1 > map->capacity * MAX_LOAD_FACTOR)
+		resize(map, map->capacity * 2);
+
+	// Αν δε βρεθεί θέση στη γειτονιά, διπλασιάζουμε τον πίνακα (μία φορά) μόνο αν είναι αρκετά γεμάτος.
+	// Διαφορετικά το key μπαίνει στο stash, εκτός αν αυτό είναι γεμάτο, οπότε ξαναχτίζουμε τον πίνακα στο
+	// ίδιο μέγεθος με νέο salt (αν δεν το έχουμε ήδη κάνει σε αυτό το μέγεθος). Αν και μετά από αυτά
+	// δε βρεθεί θέση, το key μπαίνει στο stash.
+	if (!place_node(map, key, value, hash)) {
+		bool sparse = map->size < map->capacity * MIN_RESIZE_LOAD_FACTOR;
+		if (sparse && (map->stash_size < STASH_SIZE || map->salt_capacity == map->capacity))
+			stash_push(map, key, value, hash);
+		else {
+			if (sparse)
+				reseed(map);
+			else
+				resize(map, map->capacity * 2);
+			if (!place_node(map, key, value, hash))
+				stash_push(map, key, value, hash);
+		}
+	}
+	map->size++;
+}
+
+bool map_remove(Map map, Pointer key) {
+	uint hash = map->hash_function(key);
+	MapNode node = find_node(map, key, hash);
+	if (node == MAP_EOF)
+		return false;
+
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	// Από το stash αφαιρείται μετακινώντας τον τελευταίο κόμβο στη θέση του
+	if (in_stash(map, node)) {
+		*node = map->stash[--map->stash_size];
+		map->size--;
+		return true;
+	}
+
+	// Ο κόμβος αδειάζει, και αφαιρείται από το hop bitmap της θέσης home
+	uint home = home_pos(map, hash);
+	uint offset = ((node - map->array) - home) & (map->capacity - 1);
+	map->array[home].hop &= ~((uint32_t)1 << offset);
+	node->key = EMPTY_KEY;
+	map->size--;
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->array[i].key != EMPTY_KEY) {
+			if (map->destroy_key != NULL)
+				map->destroy_key(map->array[i].key);
+			if (map->destroy_value != NULL)
+				map->destroy_value(map->array[i].value);
+		}
+	}
+
+	for (int i = 0; i < map->stash_size; i++) {
+		if (map->destroy_key != NULL)
+			map->destroy_key(map->stash[i].key);
+		if (map->destroy_value != NULL)
+			map->destroy_value(map->stash[i].value);
+	}
+
+	free(map->array);
+	free(map->stash);
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+
+// Πρώτα οι κόμβοι του πίνακα, και μετά αυτοί του stash
+
+MapNode map_first(Map map) {
+	for (int i = 0; i < map->capacity; i++)
+		if (map->array[i].key != EMPTY_KEY)
+			return &map->array[i];
+
+	return map->stash_size > 0 ? &map->stash[0] : MAP_EOF;
+}
+
+MapNode map_next(Map map, MapNode node) {
+	if (in_stash(map, node))
+		return node + 1 < map->stash + map->stash_size ? node + 1 : MAP_EOF;
+
+	for (int i = node - map->array + 1; i < map->capacity; i++)
+		if (map->array[i].key != EMPTY_KEY)
+			return &map->array[i];
+
+	return map->stash_size > 0 ? &map->stash[0] : MAP_EOF;
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	return find_node(map, key, map->hash_function(key));
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
@@ -0,0 +1,348 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Linear Hashing (Litwin)
+//
+// Το hash table αποτελείται από buckets, καθένα από τα οποία είναι μια λίστα κόμβων.
+// Αντί να δημιουργείται ολόκληρος νέος πίνακας όταν το map μεγαλώνει, σε κάθε εισαγωγή που
+// ξεπερνάει το load factor "σπάει" (split) ένα μόνο bucket, το split: οι κόμβοι του μοιράζονται
+// ανάμεσα σε αυτό και σε ένα νέο bucket στο τέλος του πίνακα, ανάλογα με ένα ακόμα bit του hash.
+// Όταν σπάσουν όλα τα buckets του τρέχοντος επιπέδου (level), ο πίνακας έχει διπλασιαστεί και το
+// split ξεκινάει πάλι από την αρχή. Αντίστοιχα, όταν το map αδειάζει, τα τελευταία buckets
+// συγχωνεύονται ένα-ένα με αυτά από τα οποία προήλθαν.
+//
+// Τα buckets βρίσκονται σε segments σταθερού μεγέθους (SEGMENT_SIZE), που δεσμεύονται όταν
+// χρειαστούν, και οι κόμβοι σε blocks των NODE_BLOCK_SIZE κόμβων. Οπότε η μνήμη αυξάνεται
+// ομαλά: καμία δέσμευση δεν είναι μεγαλύτερη από ένα segment ή ένα block (εκτός από τον
+// κατάλογο των segments, που έχει ένα pointer ανά SEGMENT_SIZE buckets), και κανένας
+// κόμβος δε μετακινείται στη μνήμη (οι MapNode παραμένουν έγκυροι μέχρι να διαγραφούν).
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ADTMap.h"
+
+
+// Πλήθος buckets ανά segment, και αρχικό πλήθος buckets (δύναμη του 2)
+#define SEGMENT_SIZE 1024
+#define INITIAL_BUCKETS SEGMENT_SIZE
+
+// Πλήθος κόμβων που δεσμεύονται μαζί
+#define NODE_BLOCK_SIZE 1024
+
+// Μέσο μήκος λίστας πάνω από το οποίο γίνεται split, και κάτω από το οποίο γίνεται συγχώνευση
+#define MAX_LOAD_FACTOR 1.0
+#define MIN_LOAD_FACTOR 0.25
+
+// Δομή του κάθε κόμβου
+struct map_node {
+	Pointer key;
+	Pointer value;
+	uint hash;			// Το (ανακατεμένο) hash code του key, ώστε να μην το ξαναυπολογίζουμε στα splits
+	MapNode next;		// Ο επόμενος κόμβος του bucket (ή της λίστας ελεύθερων κόμβων)
+};
+
+// Ένα block κόμβων
+typedef struct node_block* NodeBlock;
+
+struct node_block {
+	NodeBlock next;
+	struct map_node nodes[NODE_BLOCK_SIZE];
+};
+
+// Δομή του Map
+struct map {
+	MapNode** segments;			// Ο κατάλογος των segments, το καθένα με SEGMENT_SIZE buckets
+	int segments_capacity;		// Πόσα segments χωράνε στον κατάλογο
+	int level;					// Στην αρχή του επιπέδου level υπάρχουν INITIAL_BUCKETS << level buckets
+	uint split;					// Το επόμενο bucket που θα σπάσει (τα buckets πριν από αυτό έχουν ήδη σπάσει)
+	int size;					// Πόσα στοιχεία έχουμε προσθέσει
+	NodeBlock blocks;			// Τα blocks κόμβων που έχουμε δεσμεύσει (πρώτο το πιο πρόσφατο)
+	int block_used;				// Πόσοι κόμβοι του πιο πρόσφατου block έχουν χρησιμοποιηθεί
+	MapNode free_nodes;			// Λίστα από κόμβους που διαγράφηκαν
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+// Το bucket επιλέγεται από τα χαμηλά bits του hash code, οπότε ανακατεύουμε πρώτα τα bits του
+// (finalizer του MurmurHash3), ώστε πχ το hash_int διαδοχικών αριθμών να μη δίνει διαδοχικά buckets.
+static inline uint mix_hash(uint hash) {
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+// Πλήθος των buckets που υπάρχουν αυτή τη στιγμή
+static inline uint bucket_count(Map map) {
+	return ((uint)INITIAL_BUCKETS << map->level) + map->split;
+}
+
+// Το bucket ενός hash code: με τα bits του επιπέδου, ή με ένα ακόμα bit αν το bucket έχει ήδη σπάσει
+static inline uint bucket_of(Map map, uint hash) {
+	uint bucket = hash & (((uint)INITIAL_BUCKETS << map->level) - 1);
+	if (bucket < map->split)
+		bucket = hash & (((uint)INITIAL_BUCKETS << (map->level + 1)) - 1);
+	return bucket;
+}
+
+// Η κεφαλή της λίστας του bucket
+static inline MapNode* bucket_at(Map map, uint bucket) {
+	return &map->segments[bucket / SEGMENT_SIZE][bucket % SEGMENT_SIZE];
+}
+
+// Δεσμεύει (αν χρειάζεται) το segment στο οποίο ανήκει το bucket
+
+static void ensure_segment(Map map, uint bucket) {
+	int segment = bucket / SEGMENT_SIZE;
+	if (segment == map->segments_capacity) {
+		map->segments_capacity *= 2;
+		map->segments = realloc(map->segments, map->segments_capacity * sizeof(*map->segments));
+	}
+	if (bucket % SEGMENT_SIZE == 0)
+		map->segments[segment] = calloc(SEGMENT_SIZE, sizeof(MapNode));
+}
+
+// Επιστρέφει έναν κόμβο από τη λίστα κόμβων που διαγράφηκαν, ή τον επόμενο αχρησιμοποίητο κόμβο του πιο
+// πρόσφατου block. Οι κόμβοι ενός block δίνονται με τη σειρά (και όχι όλοι μαζί μέσω της λίστας), ώστε η
+// μνήμη του block να αγγίζεται σταδιακά και τα page faults να μοιράζονται σε πολλές εισαγωγές.
+
+static MapNode allocate_node(Map map) {
+	MapNode node = map->free_nodes;
+	if (node != NULL) {
+		map->free_nodes = node->next;
+		return node;
+	}
+
+	if (map->blocks == NULL || map->block_used == NODE_BLOCK_SIZE) {
+		NodeBlock block = malloc(sizeof(*block));
+		block->next = map->blocks;
+		map->blocks = block;
+		map->block_used = 0;
+	}
+	return &map->blocks->nodes[map->block_used++];
+}
+
+// Σπάει το bucket split σε αυτό και στο bucket split + (INITIAL_BUCKETS << level), που προστίθεται στο τέλος
+
+static void split_bucket(Map map) {
+	uint new_bucket = bucket_count(map);
+	ensure_segment(map, new_bucket);
+
+	uint high_bit = (uint)INITIAL_BUCKETS << map->level;
+	MapNode* old_list = bucket_at(map, map->split);
+	MapNode* new_list = bucket_at(map, new_bucket);
+
+	// Οι κόμβοι με το bit high_bit του hash μεταφέρονται στο νέο bucket
+	for (MapNode* link = old_list; *link != NULL; ) {
+		MapNode node = *link;
+		if (node->hash & high_bit) {
+			*link = node->next;
+			node->next = *new_list;
+			*new_list = node;
+		} else {
+			link = &node->next;
+		}
+	}
+
+	if (++map->split == high_bit) {
+		map->level++;
+		map->split = 0;
+	}
+}
+
+// Το αντίστροφο του split_bucket: το τελευταίο bucket συγχωνεύεται με αυτό από το οποίο προήλθε
+
+static void merge_bucket(Map map) {
+	if (map->split == 0) {
+		map->level--;
+		map->split = (uint)INITIAL_BUCKETS << map->level;
+	}
+	map->split--;
+
+	uint last = bucket_count(map);
+	MapNode* last_list = bucket_at(map, last);
+	MapNode* list = bucket_at(map, map->split);
+
+	// Η σειρά των κόμβων σε ένα bucket δεν έχει σημασία, οπότε απλά μεταφέρουμε έναν-έναν στην αρχή
+	while (*last_list != NULL) {
+		MapNode node = *last_list;
+		*last_list = node->next;
+		node->next = *list;
+		*list = node;
+	}
+
+	if (last % SEGMENT_SIZE == 0)
+		free(map->segments[last / SEGMENT_SIZE]);
+}
+
+// Επιστρέφει τον σύνδεσμο (κεφαλή λίστας ή πεδίο next) που δείχνει στον κόμβο με κλειδί key, ή στο τέλος
+// της λίστας (NULL) αν το key δεν υπάρχει. Ο σύνδεσμος επιτρέπει στη map_remove να αφαιρέσει τον κόμβο.
+
+static MapNode* find_link(Map map, Pointer key, uint hash) {
+	MapNode* link = bucket_at(map, bucket_of(map, hash));
+	while (*link != NULL && ((*link)->hash != hash || map->compare((*link)->key, key) != 0))
+		link = &(*link)->next;
+	return link;
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+
+	map->segments_capacity = 1;
+	map->segments = malloc(sizeof(*map->segments));
+	map->segments[0] = calloc(SEGMENT_SIZE, sizeof(MapNode));
+	map->level = 0;
+	map->split = 0;
+
+	map->size = 0;
+	map->blocks = NULL;
+	map->block_used = 0;
+	map->free_nodes = NULL;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint hash = mix_hash(map->hash_function(key));
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value
+	MapNode* link = find_link(map, key, hash);
+	MapNode node = *link;
+	if (node != NULL) {
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	// Ο νέος κόμβος μπαίνει στο τέλος της λίστας (εκεί που σταμάτησε η αναζήτηση)
+	node = allocate_node(map);
+	node->key = key;
+	node->value = value;
+	node->hash = hash;
+	node->next = NULL;
+	*link = node;
+	map->size++;
+
+	// Το πολύ ένα split ανά εισαγωγή, ώστε ο χρόνος κάθε εισαγωγής να είναι φραγμένος
+	if (map->size > bucket_count(map) * MAX_LOAD_FACTOR)
+		split_bucket(map);
+}
+
+bool map_remove(Map map, Pointer key) {
+	MapNode* link = find_link(map, key, mix_hash(map->hash_function(key)));
+	MapNode node = *link;
+	if (node == NULL)
+		return false;
+
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	*link = node->next;
+	node->next = map->free_nodes;
+	map->free_nodes = node;
+	map->size--;
+
+	if (map->size < bucket_count(map) * MIN_LOAD_FACTOR && bucket_count(map) > INITIAL_BUCKETS)
+		merge_bucket(map);
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	if (map->destroy_key != NULL || map->destroy_value != NULL) {
+		for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+			if (map->destroy_key != NULL)
+				map->destroy_key(node->key);
+			if (map->destroy_value != NULL)
+				map->destroy_value(node->value);
+		}
+	}
+
+	for (uint i = 0; i < bucket_count(map); i += SEGMENT_SIZE)
+		free(map->segments[i / SEGMENT_SIZE]);
+	free(map->segments);
+
+	while (map->blocks != NULL) {
+		NodeBlock next = map->blocks->next;
+		free(map->blocks);
+		map->blocks = next;
+	}
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+
+// Ο πρώτος κόμβος από το bucket και μετά
+static MapNode first_from(Map map, uint bucket) {
+	for (uint count = bucket_count(map); bucket < count; bucket++)
+		if (*bucket_at(map, bucket) != NULL)
+			return *bucket_at(map, bucket);
+
+	return MAP_EOF;
+}
+
+MapNode map_first(Map map) {
+	return first_from(map, 0);
+}
+
+MapNode map_next(Map map, MapNode node) {
+	return node->next != NULL ? node->next : first_from(map, bucket_of(map, node->hash) + 1);
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	return *find_link(map, key, mix_hash(map->hash_function(key)));
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
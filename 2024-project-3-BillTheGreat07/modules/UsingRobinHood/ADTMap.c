@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Hash Table με open addressing (Robin Hood hashing)
+//
+// Κάθε κόμβος αποθηκεύει την απόσταση από τη θέση στην οποία κάνει hash το key του.
+// Κατά την εισαγωγή, ένα key που έχει "ταξιδέψει" περισσότερο παίρνει τη θέση ενός key
+// που είναι πιο κοντά στη δική του θέση, οπότε οι αποστάσεις μένουν μικρές και ομοιόμορφες.
+// Η αναζήτηση σταματάει μόλις συναντήσει κόμβο με μικρότερη απόσταση από τη δική της.
+//
+// Η διαγραφή γίνεται με backward shift: οι επόμενοι κόμβοι της ακολουθίας μετακινούνται μια
+// θέση πίσω, οπότε δεν υπάρχουν DELETED κόμβοι και ο πίνακας δε γεμίζει ποτέ από αυτούς.
+// Αυτό σημαίνει όμως ότι μετά από map_remove οι MapNode που έχουμε κρατήσει δεν είναι έγκυροι.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "ADTMap.h"
+
+
+// Το μέγεθος του πίνακα είναι δύναμη του 2, και η θέση κάθε key υπολογίζεται με Fibonacci hashing
+#define INITIAL_CAPACITY 64
+#define FIBONACCI_MULTIPLIER 2654435769u
+
+// Χάρη στις μικρές αποστάσεις, το Robin Hood hashing δουλεύει καλά με αρκετά υψηλότερο load factor
+// από το απλό linear probing. Δεν υπάρχουν DELETED, οπότε μετράει μόνο το size.
+#define MAX_LOAD_FACTOR 0.8
+
+// Δομή του κάθε κόμβου
+struct map_node {
+	Pointer key;
+	Pointer value;
+	uint hash;			// Το hash code του key, ώστε να μην το ξαναυπολογίζουμε στο rehash
+	uint distance;		// 1 + η απόσταση από τη θέση που κάνει hash το key, 0 αν ο κόμβος είναι κενός
+};
+
+// Δομή του Map
+struct map {
+	MapNode array;				// Ο πίνακας του hash table
+	int capacity;				// Πόσο χώρο έχουμε δεσμεύσει (δύναμη του 2)
+	int shift;					// 32 - log2(capacity), για τον υπολογισμό της αρχικής θέσης
+	int size;					// Πόσα στοιχεία έχουμε προσθέσει
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+// Η θέση στην οποία κάνει hash ένα hash code
+static inline uint home_pos(Map map, uint hash) {
+	return (hash * FIBONACCI_MULTIPLIER) >> map->shift;
+}
+
+// Η επόμενη θέση, γυρνώντας στην αρχή όταν φτάσουμε στο τέλος του πίνακα
+static inline uint next_pos(Map map, uint pos) {
+	return (pos + 1) & (map->capacity - 1);
+}
+
+// Δεσμεύει έναν κενό πίνακα μεγέθους capacity
+static void allocate_array(Map map, int capacity) {
+	map->capacity = capacity;
+	map->shift = 32 - __builtin_ctz(capacity);
+	map->array = malloc(capacity * sizeof(struct map_node));
+	for (int i = 0; i < capacity; i++)
+		map->array[i].distance = 0;
+}
+
+// Τοποθετεί τον κόμβο node, του οποίου το key σίγουρα δεν υπάρχει στο map.
+// Ξεκινώντας από τη θέση του hash, όποτε βρούμε κόμβο με μικρότερη απόσταση από τον δικό μας
+// ανταλλάσσουμε τους δύο κόμβους, και συνεχίζουμε τοποθετώντας αυτόν που βγήκε από τον πίνακα.
+
+static void place_node(Map map, struct map_node node) {
+	node.distance = 1;
+	for (uint pos = home_pos(map, node.hash); ; pos = next_pos(map, pos), node.distance++) {
+		MapNode current = &map->array[pos];
+		if (current->distance == 0) {
+			*current = node;
+			return;
+		}
+		if (current->distance < node.distance) {
+			struct map_node displaced = *current;
+			*current = node;
+			node = displaced;
+		}
+	}
+}
+
+// Αλλάζει το μέγεθος του πίνακα σε new_capacity, χρησιμοποιώντας τα αποθηκευμένα hash codes
+static void resize(Map map, int new_capacity) {
+	MapNode old_array = map->array;
+	int old_capacity = map->capacity;
+
+	allocate_array(map, new_capacity);
+	for (int i = 0; i < old_capacity; i++)
+		if (old_array[i].distance != 0)
+			place_node(map, old_array[i]);
+
+	free(old_array);
+}
+
+// Αναζητά τον κόμβο με κλειδί key, του οποίου το hash code είναι hash
+
+static MapNode find_node(Map map, Pointer key, uint hash) {
+	// Αν συναντήσουμε κόμβο με μικρότερη απόσταση από αυτή που έχουμε διανύσει (ή κενό κόμβο, με απόσταση 0),
+	// τότε το key δεν υπάρχει: αν υπήρχε, η εισαγωγή θα το είχε τοποθετήσει στη θέση του κόμβου αυτού.
+	uint distance = 1;
+	for (uint pos = home_pos(map, hash); map->array[pos].distance >= distance; pos = next_pos(map, pos), distance++) {
+		if (map->array[pos].hash == hash && map->compare(map->array[pos].key, key) == 0)
+			return &map->array[pos];
+	}
+	return MAP_EOF;
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+	allocate_array(map, INITIAL_CAPACITY);
+
+	map->size = 0;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint hash = map->hash_function(key);
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value
+	MapNode node = find_node(map, key, hash);
+	if (node != MAP_EOF) {
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	if (map->size + 1 > map->capacity * MAX_LOAD_FACTOR)
+		resize(map, map->capacity * 2);
+
+	struct map_node new_node = { .key = key, .value = value, .hash = hash };
+	place_node(map, new_node);
+	map->size++;
+}
+
+bool map_remove(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	if (node == MAP_EOF)
+		return false;
+
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	// Backward shift: μετακινούμε μια θέση πίσω τους επόμενους κόμβους, μέχρι να βρούμε
+	// κενό κόμβο ή κόμβο που βρίσκεται ήδη στη θέση που κάνει hash (απόσταση 1).
+	uint pos = node - map->array;
+	for (uint next = next_pos(map, pos); map->array[next].distance > 1; pos = next, next = next_pos(map, next)) {
+		map->array[pos] = map->array[next];
+		map->array[pos].distance--;
+	}
+	map->array[pos].distance = 0;
+	map->size--;
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->array[i].distance != 0) {
+			if (map->destroy_key != NULL)
+				map->destroy_key(map->array[i].key);
+			if (map->destroy_value != NULL)
+				map->destroy_value(map->array[i].value);
+		}
+	}
+
+	free(map->array);
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+
+MapNode map_first(Map map) {
+	for (int i = 0; i < map->capacity; i++)
+		if (map->array[i].distance != 0)
+			return &map->array[i];
+
+	return MAP_EOF;
+}
+
+MapNode map_next(Map map, MapNode node) {
+	for (int i = node - map->array + 1; i < map->capacity; i++)
+		if (map->array[i].distance != 0)
+			return &map->array[i];
+
+	return MAP_EOF;
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	return find_node(map, key, map->hash_function(key));
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
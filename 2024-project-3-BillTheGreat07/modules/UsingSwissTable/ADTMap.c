@@ -0,0 +1,349 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Υλοποίηση του ADT Map μέσω Swiss Table: hash table με open addressing, στο
+// οποίο η κατάσταση κάθε κελιού κρατιέται σε ξεχωριστό πίνακα από control bytes.
+//
+// Κάθε control byte είναι EMPTY, DELETED, ή (για κατειλημμένα κελιά) τα 7 bits
+// του hash code (h2) του key. Η αναζήτηση εξετάζει 16 κελιά τη φορά, συγκρίνοντας
+// με μία SSE2 εντολή 16 control bytes με το h2 του key. Η compare καλείται μόνο
+// στα κελιά που ταιριάζει το h2, και μόνο τότε διαβάζουμε τον ίδιο τον κόμβο.
+//
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ADTMap.h"
+
+
+// Τα κελιά εξετάζονται σε ομάδες των GROUP_SIZE (όσα bytes χωράει ένας SSE2 καταχωρητής)
+#define GROUP_SIZE 16
+
+// Τιμές των control bytes. Τα κατειλημμένα κελιά έχουν τιμή 0..127 (το h2), οπότε τα
+// EMPTY/DELETED είναι ακριβώς αυτά που έχουν το υψηλό bit ενεργό.
+#define CTRL_EMPTY   ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// Το μέγεθος του πίνακα είναι πάντα δύναμη του 2 και τουλάχιστον GROUP_SIZE
+#define INITIAL_CAPACITY GROUP_SIZE
+
+// Τα control bytes επιτρέπουν πολύ υψηλότερο load factor απ' ότι το απλό linear probing.
+// Στο load factor μετράμε και τα DELETED.
+#define MAX_LOAD_FACTOR 0.875
+
+// Σταθερά του Fibonacci hashing (2^64 / φ), για ανακάτεμα των bits του hash code
+#define FIBONACCI_MULTIPLIER 11400714819323198485ull
+
+// Δομή του κάθε κόμβου. Η κατάσταση και το h2 βρίσκονται στα control bytes,
+// οπότε ο κόμβος έχει μόνο key και value (16 bytes).
+struct map_node {
+	Pointer key;
+	Pointer value;
+};
+
+// Δομή του Map
+struct map {
+	int8_t* ctrl;				// capacity + GROUP_SIZE control bytes. Τα τελευταία GROUP_SIZE είναι αντίγραφο των
+								// πρώτων, ώστε μια ομάδα που ξεκινάει κοντά στο τέλος να "γυρνάει" στην αρχή.
+	MapNode slots;				// Οι κόμβοι, ένας για κάθε control byte
+	int capacity;				// Πόσο χώρο έχουμε δεσμεύσει (δύναμη του 2)
+	int shift;					// 64 - log2(capacity), για τον υπολογισμό της αρχικής θέσης
+	int size;					// Πόσα στοιχεία έχουμε προσθέσει
+	int deleted;				// Πόσα κελιά είναι DELETED
+	CompareFunc compare;		// Συνάρτηση για σύγκριση δεικτών, που πρέπει να δίνεται απο τον χρήστη
+	HashFunc hash_function;		// Συνάρτηση για να παίρνουμε το hash code του κάθε αντικειμένου.
+	DestroyFunc destroy_key;	// Συναρτήσεις που καλούνται όταν διαγράφουμε έναν κόμβο απο το map.
+	DestroyFunc destroy_value;
+};
+
+
+// Λειτουργίες πάνω σε μια ομάδα GROUP_SIZE control bytes. Επιστρέφουν ένα bitmask, με το bit i
+// ενεργό αν το control byte i της ομάδας ικανοποιεί τη συνθήκη.
+
+// Control bytes ίσα με tag
+static inline uint group_match(const int8_t* group, int8_t tag) {
+#ifdef __SSE2__
+	__m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag)));
+#else
+	uint mask = 0;
+	for (int i = 0; i < GROUP_SIZE; i++)
+		if (group[i] == tag)
+			mask |= 1u << i;
+	return mask;
+#endif
+}
+
+// Control bytes EMPTY ή DELETED (δηλαδή με το υψηλό bit ενεργό)
+static inline uint group_match_free(const int8_t* group) {
+#ifdef __SSE2__
+	return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+	uint mask = 0;
+	for (int i = 0; i < GROUP_SIZE; i++)
+		if (group[i] < 0)
+			mask |= 1u << i;
+	return mask;
+#endif
+}
+
+// Χωρίζουμε το (ανακατεμένο) hash code σε h1, που καθορίζει την αρχική θέση, και h2 (7 bits) που
+// αποθηκεύεται στο control byte. Τα δύο προέρχονται από διαφορετικά bits, ώστε να είναι ανεξάρτητα: h1 είναι
+// τα υψηλά bits του γινομένου και h2 τα 7 αμέσως από κάτω. Τα χαμηλά bits του γινομένου δε θα έκαναν, γιατί
+// εξαρτώνται μόνο από τα χαμηλά bits του hash code (πχ με ένα identity hash όλα τα πολλαπλάσια του 128
+// θα είχαν το ίδιο h2).
+
+static inline uint64_t mix(uint hash) {
+	return (uint64_t)hash * FIBONACCI_MULTIPLIER;
+}
+
+static inline uint h1(Map map, uint64_t mixed) {
+	return mixed >> map->shift;
+}
+
+static inline int8_t h2(Map map, uint64_t mixed) {
+	return (mixed >> (map->shift - 7)) & 0x7F;
+}
+
+// Αλλάζει το control byte της θέσης pos, ενημερώνοντας και το αντίγραφο στο τέλος του πίνακα
+static inline void set_ctrl(Map map, uint pos, int8_t tag) {
+	map->ctrl[pos] = tag;
+	if (pos < GROUP_SIZE)
+		map->ctrl[map->capacity + pos] = tag;
+}
+
+// Δεσμεύει πίνακες (κενούς) μεγέθους capacity
+static void allocate_arrays(Map map, int capacity) {
+	map->capacity = capacity;
+	map->shift = 64 - __builtin_ctz(capacity);
+	map->slots = malloc(capacity * sizeof(struct map_node));
+	map->ctrl = malloc(capacity + GROUP_SIZE);
+	for (int i = 0; i < capacity + GROUP_SIZE; i++)
+		map->ctrl[i] = CTRL_EMPTY;
+}
+
+// Βρίσκει την πρώτη EMPTY ή DELETED θέση στην ακολουθία αναζήτησης του mixed.
+//
+// Η ακολουθία εξετάζει ομάδες στις θέσεις h1, h1 + 16, h1 + 16 + 32, ... (τριγωνικοί αριθμοί επί GROUP_SIZE).
+// Σε πίνακα μεγέθους δύναμης του 2 η ακολουθία αυτή περνάει από όλες τις ομάδες, και αφού ο load factor
+// είναι < 1 σίγουρα υπάρχει EMPTY θέση, οπότε η αναζήτηση πάντα τερματίζει.
+
+static uint find_free_pos(Map map, uint64_t mixed) {
+	uint mask = map->capacity - 1;
+	uint pos = h1(map, mixed);
+	for (uint step = GROUP_SIZE; ; pos = (pos + step) & mask, step += GROUP_SIZE) {
+		uint free = group_match_free(&map->ctrl[pos]);
+		if (free != 0)
+			return (pos + __builtin_ctz(free)) & mask;
+	}
+}
+
+// Αλλάζει το μέγεθος του πίνακα σε new_capacity, μεταφέροντας όλους τους κόμβους.
+// Τα DELETED δεν μεταφέρονται, οπότε με new_capacity == capacity απλά καθαρίζουμε τον πίνακα.
+
+static void resize(Map map, int new_capacity) {
+	int8_t* old_ctrl = map->ctrl;
+	MapNode old_slots = map->slots;
+	int old_capacity = map->capacity;
+
+	allocate_arrays(map, new_capacity);
+	for (int i = 0; i < old_capacity; i++) {
+		if (old_ctrl[i] >= 0) {
+			uint64_t mixed = mix(map->hash_function(old_slots[i].key));
+			uint pos = find_free_pos(map, mixed);
+			set_ctrl(map, pos, h2(map, mixed));
+			map->slots[pos] = old_slots[i];
+		}
+	}
+	map->deleted = 0;
+
+	free(old_ctrl);
+	free(old_slots);
+}
+
+// Αναζητά τον κόμβο με κλειδί key, με ήδη ανακατεμένο hash code mixed
+
+static MapNode find_node(Map map, Pointer key, uint64_t mixed) {
+	uint mask = map->capacity - 1;
+	int8_t tag = h2(map, mixed);
+	uint pos = h1(map, mixed);
+
+	for (uint step = GROUP_SIZE; ; pos = (pos + step) & mask, step += GROUP_SIZE) {
+		const int8_t* group = &map->ctrl[pos];
+
+		// Ελέγχουμε μόνο τα κελιά της ομάδας που έχουν το ίδιο h2 με το key
+		for (uint match = group_match(group, tag); match != 0; match &= match - 1) {
+			uint i = (pos + __builtin_ctz(match)) & mask;
+			if (map->compare(map->slots[i].key, key) == 0)
+				return &map->slots[i];
+		}
+
+		// Αν η ομάδα έχει EMPTY κελί, το key σίγουρα δεν βρίσκεται πιο μετά
+		if (group_match(group, CTRL_EMPTY) != 0)
+			return MAP_EOF;
+	}
+}
+
+
+Map map_create(CompareFunc compare, DestroyFunc destroy_key, DestroyFunc destroy_value) {
+	Map map = malloc(sizeof(*map));
+	allocate_arrays(map, INITIAL_CAPACITY);
+
+	map->size = 0;
+	map->deleted = 0;
+	map->compare = compare;
+	map->hash_function = NULL;
+	map->destroy_key = destroy_key;
+	map->destroy_value = destroy_value;
+
+	return map;
+}
+
+int map_size(Map map) {
+	return map->size;
+}
+
+void map_insert(Map map, Pointer key, Pointer value) {
+	uint64_t mixed = mix(map->hash_function(key));
+
+	// Αν το key υπάρχει ήδη, αντικαθιστούμε key/value
+	MapNode node = find_node(map, key, mixed);
+	if (node != MAP_EOF) {
+		if (node->key != key && map->destroy_key != NULL)
+			map->destroy_key(node->key);
+
+		if (node->value != value && map->destroy_value != NULL)
+			map->destroy_value(node->value);
+
+		node->key = key;
+		node->value = value;
+		return;
+	}
+
+	// Νέο στοιχείο. Αν ξεπερνάμε το μέγιστο load factor κάνουμε rehash: αν τα περισσότερα μη-ελεύθερα
+	// κελιά είναι DELETED αρκεί να καθαρίσουμε τον πίνακα στο ίδιο μέγεθος, διαφορετικά τον διπλασιάζουμε.
+	if (map->size + map->deleted + 1 > map->capacity * MAX_LOAD_FACTOR) {
+		if (map->size + 1 <= map->capacity * MAX_LOAD_FACTOR / 2)
+			resize(map, map->capacity);
+		else
+			resize(map, map->capacity * 2);
+	}
+
+	uint pos = find_free_pos(map, mixed);
+	if (map->ctrl[pos] == CTRL_DELETED)
+		map->deleted--;
+
+	set_ctrl(map, pos, h2(map, mixed));
+	map->slots[pos].key = key;
+	map->slots[pos].value = value;
+	map->size++;
+}
+
+bool map_remove(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	if (node == MAP_EOF)
+		return false;
+
+	if (map->destroy_key != NULL)
+		map->destroy_key(node->key);
+	if (map->destroy_value != NULL)
+		map->destroy_value(node->value);
+
+	// Το κελί μπορεί να γίνει EMPTY (αντί για DELETED) αν καμία αναζήτηση δεν έχει περάσει ποτέ από αυτό
+	// χωρίς να σταματήσει. Αυτό ισχύει αν κάθε ομάδα GROUP_SIZE κελιών που το περιέχει έχει και ένα EMPTY κελί:
+	// τότε καμία ομάδα που περιέχει το κελί δεν ήταν ποτέ γεμάτη, οπότε καμία αναζήτηση δεν συνέχισε μετά από αυτή.
+	uint mask = map->capacity - 1;
+	uint pos = node - map->slots;
+	uint empty_after = group_match(&map->ctrl[pos], CTRL_EMPTY);
+	uint empty_before = group_match(&map->ctrl[(pos - GROUP_SIZE) & mask], CTRL_EMPTY);
+
+	bool never_full = empty_after != 0 && empty_before != 0 &&
+		__builtin_ctz(empty_after) + (__builtin_clz(empty_before) - (32 - GROUP_SIZE)) < GROUP_SIZE;
+
+	if (never_full) {
+		set_ctrl(map, pos, CTRL_EMPTY);
+	} else {
+		set_ctrl(map, pos, CTRL_DELETED);
+		map->deleted++;
+	}
+	map->size--;
+
+	return true;
+}
+
+Pointer map_find(Map map, Pointer key) {
+	MapNode node = map_find_node(map, key);
+	return node != MAP_EOF ? node->value : NULL;
+}
+
+DestroyFunc map_set_destroy_key(Map map, DestroyFunc destroy_key) {
+	DestroyFunc old = map->destroy_key;
+	map->destroy_key = destroy_key;
+	return old;
+}
+
+DestroyFunc map_set_destroy_value(Map map, DestroyFunc destroy_value) {
+	DestroyFunc old = map->destroy_value;
+	map->destroy_value = destroy_value;
+	return old;
+}
+
+void map_destroy(Map map) {
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->ctrl[i] >= 0) {
+			if (map->destroy_key != NULL)
+				map->destroy_key(map->slots[i].key);
+			if (map->destroy_value != NULL)
+				map->destroy_value(map->slots[i].value);
+		}
+	}
+
+	free(map->ctrl);
+	free(map->slots);
+	free(map);
+}
+
+/////////////////////// Διάσχιση του map μέσω κόμβων ///////////////////////////
+
+// Επιστρέφει τον πρώτο κατειλημμένο κόμβο από τη θέση start και μετά, εξετάζοντας μια ομάδα τη φορά
+
+static MapNode next_occupied(Map map, uint start) {
+	for (uint pos = start; pos < (uint)map->capacity; pos += GROUP_SIZE) {
+		uint occupied = ~group_match_free(&map->ctrl[pos]) & ((1u << GROUP_SIZE) - 1);
+		if (occupied != 0) {
+			// Η ομάδα μπορεί να περιέχει και αντίγραφα των πρώτων control bytes, τα αγνοούμε
+			uint i = pos + __builtin_ctz(occupied);
+			return i < (uint)map->capacity ? &map->slots[i] : MAP_EOF;
+		}
+	}
+	return MAP_EOF;
+}
+
+MapNode map_first(Map map) {
+	return next_occupied(map, 0);
+}
+
+MapNode map_next(Map map, MapNode node) {
+	return next_occupied(map, node - map->slots + 1);
+}
+
+Pointer map_node_key(Map map, MapNode node) {
+	return node->key;
+}
+
+Pointer map_node_value(Map map, MapNode node) {
+	return node->value;
+}
+
+MapNode map_find_node(Map map, Pointer key) {
+	return find_node(map, key, mix(map->hash_function(key)));
+}
+
+void map_set_hash_function(Map map, HashFunc func) {
+	map->hash_function = func;
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: δημιουργία και καταστροφή ενός λεξικού με N string keys
+// (πχ 10M), με strdup + map_insert (destroy_key = free) έναντι
+// map_insert_copy_string (τα keys αντιγράφονται στο arena του map).
+//
+// Χρήση: ./arena_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_strings(Pointer a, Pointer b) {
+	return strcmp(a, b);
+}
+
+// Τα keys διαβάζονται ένα-ένα σε ένα buffer (όπως από αρχείο), οπότε πρέπει να αντιγραφούν για να μπουν στο map
+
+static void make_key(char* buffer, int i) {
+	sprintf(buffer, "word_%d", i);
+}
+
+// "Τυχαία" σειρά των αριθμών 0..n-1 (με σταθερό seed), για τις αναζητήσεις
+
+static int* shuffled_indices(int n) {
+	int* order = malloc(n * sizeof(*order));
+	for (int i = 0; i < n; i++)
+		order[i] = i;
+	srand(0);
+	for (int i = n - 1; i > 0; i--) {
+		int j = ((long)rand() * RAND_MAX + rand()) % (i + 1);
+		int temp = order[i];
+		order[i] = order[j];
+		order[j] = temp;
+	}
+	return order;
+}
+
+static void build_and_destroy(int n, bool copy_string) {
+	char buffer[32];
+	double start = bench_now();
+	Map map = map_create(compare_strings, copy_string ? NULL : free, NULL);
+	map_set_hash_function(map, hash_string);
+	for (int i = 0; i < n; i++) {
+		make_key(buffer, i);
+		if (copy_string)
+			map_insert_copy_string(map, buffer, (Pointer)(intptr_t)i);
+		else
+			map_insert(map, strdup(buffer), (Pointer)(intptr_t)i);
+	}
+	bench_report(copy_string ? "map_insert_copy_string" : "strdup + map_insert", n, bench_now() - start);
+	printf("%-32s %10ld RSS (KB)\n", "", bench_rss_kb());
+
+	// Ελεγχος ότι όλα τα keys υπάρχουν, με τυχαία σειρά (όχι τη σειρά με την οποία δεσμεύτηκαν τα strdup)
+	int* order = shuffled_indices(n);
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++) {
+		make_key(buffer, order[i]);
+		errors += (intptr_t)map_find(map, buffer) != order[i];
+	}
+	bench_report("map_find", n, bench_now() - start);
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	free(order);
+
+	start = bench_now();
+	map_destroy(map);
+	bench_report("map_destroy", n, bench_now() - start);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 10000000;
+
+	// Κάθε εκδοχή σε ξεχωριστή διεργασία, ώστε η μνήμη που αποδέσμευσε η μία να μην επηρεάζει την άλλη
+	for (int copy_string = 0; copy_string <= 1; copy_string++) {
+		fflush(stdout);
+		pid_t pid = fork();
+		if (pid == 0) {
+			build_and_destroy(n, copy_string);
+			exit(0);
+		}
+		waitpid(pid, NULL, 0);
+	}
+	return 0;
+}
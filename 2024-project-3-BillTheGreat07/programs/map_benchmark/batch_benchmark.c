@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: αναζητήσεις και εισαγωγές σε ομάδες (map_find_many,
+// map_insert_many) έναντι ενός loop από map_find / map_insert, σε
+// map πολύ μεγαλύτερο από το cache του επεξεργαστή.
+//
+// Χρήση: ./batch_benchmark [N] [BATCH]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Ανακατεύει τον πίνακα array (με σταθερό seed)
+
+static void shuffle(Pointer* array, int n) {
+	srand(0);
+	for (int i = n - 1; i > 0; i--) {
+		int j = ((long)rand() * RAND_MAX + rand()) % (i + 1);
+		Pointer temp = array[i];
+		array[i] = array[j];
+		array[j] = temp;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 4000000;
+	int batch = argc > 2 ? atoi(argv[2]) : 1000;
+
+	// Κάθε key δεσμεύεται χωριστά (όπως σε μια πραγματική εφαρμογή), και οι τιμές είναι
+	// διαφορετικές αλλά "τυχαίες", ώστε διαδοχικά keys να πέφτουν σε μακρινές θέσεις του πίνακα.
+	Pointer* keys = malloc(n * sizeof(*keys));
+	for (int i = 0; i < n; i++) {
+		int* key = malloc(sizeof(*key));
+		*key = (int)((unsigned)i * 2654435761u);
+		keys[i] = key;
+	}
+	Pointer* values = malloc(n * sizeof(*values));
+
+	// Εισαγωγές
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	double start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_insert(map, keys[i], keys[i]);
+	bench_report("map_insert loop", n, bench_now() - start);
+	map_destroy(map);
+
+	map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	start = bench_now();
+	for (int i = 0; i < n; i += batch)
+		map_insert_many(map, &keys[i], &keys[i], n - i < batch ? n - i : batch);
+	bench_report("map_insert_many", n, bench_now() - start);
+
+	printf("%-32s %10ld RSS (KB)\n", "", bench_rss_kb());
+
+	// Αναζητήσεις με τυχαία σειρά
+	shuffle(keys, n);
+
+	start = bench_now();
+	long found = 0;
+	for (int i = 0; i < n; i++)
+		found += map_find(map, keys[i]) != NULL;
+	bench_report("map_find loop", n, bench_now() - start);
+
+	start = bench_now();
+	for (int i = 0; i < n; i += batch)
+		map_find_many(map, &keys[i], n - i < batch ? n - i : batch, &values[i]);
+	bench_report("map_find_many", n, bench_now() - start);
+
+	for (int i = 0; i < n; i++)
+		found -= values[i] != NULL;
+	if (found != 0)
+		printf("error: map_find and map_find_many disagree\n");
+
+	map_destroy(map);
+	for (int i = 0; i < n; i++)
+		free(keys[i]);
+	free(keys);
+	free(values);
+	return 0;
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////
+//
+// Βοηθητικές συναρτήσεις για τα benchmarks του ADT Map
+//
+///////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L		// για την clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "benchmark.h"
+
+
+double bench_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+long bench_rss_kb(void) {
+	// Στο Linux η τρέχουσα μνήμη βρίσκεται στο /proc/self/statm (σε σελίδες). Σε άλλα συστήματα
+	// επιστρέφουμε το μέγιστο RSS μέχρι στιγμής, που για σταθερή μνήμη είναι το ίδιο.
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (file != NULL) {
+		long size, resident;
+		int read = fscanf(file, "%ld %ld", &size, &resident);
+		fclose(file);
+		if (read == 2)
+			return resident * (sysconf(_SC_PAGESIZE) / 1024);
+	}
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+long bench_peak_rss_kb(void) {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+char** bench_create_strings(int n, const char* prefix) {
+	char** strings = malloc(n * sizeof(*strings));
+	for (int i = 0; i < n; i++) {
+		int len = snprintf(NULL, 0, "%s%d", prefix, i);
+		strings[i] = malloc(len + 1);
+		snprintf(strings[i], len + 1, "%s%d", prefix, i);
+	}
+	return strings;
+}
+
+void bench_free_strings(char** strings, int n) {
+	for (int i = 0; i < n; i++)
+		free(strings[i]);
+	free(strings);
+}
+
+void bench_shuffle_strings(char** strings, int n) {
+	srand(0);
+	for (int i = n - 1; i > 0; i--) {
+		int j = ((long)rand() * RAND_MAX + rand()) % (i + 1);
+		char* t = strings[i];
+		strings[i] = strings[j];
+		strings[j] = t;
+	}
+}
+
+void bench_report(const char* name, int ops, double seconds) {
+	printf("%-32s %10d ops %10.3f sec %10.1f ns/op\n", name, ops, seconds, seconds * 1e9 / ops);
+}
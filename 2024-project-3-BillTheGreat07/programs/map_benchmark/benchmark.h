@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////
+//
+// Βοηθητικές συναρτήσεις για τα benchmarks του ADT Map
+//
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include το πολύ μία φορά
+
+#include "common_types.h"
+
+
+// Επιστρέφει τον τρέχοντα χρόνο σε δευτερόλεπτα (monotonic clock, κατάλληλο για μετρήσεις διαρκειών)
+
+double bench_now(void);
+
+// Επιστρέφει τη μνήμη που χρησιμοποιεί αυτή τη στιγμή το πρόγραμμα (resident set size) σε KB
+
+long bench_rss_kb(void);
+
+// Επιστρέφει τη μέγιστη μνήμη (RSS) που έχει χρησιμοποιήσει το πρόγραμμα μέχρι στιγμής, σε KB
+
+long bench_peak_rss_kb(void);
+
+// Επιστρέφει έναν πίνακα με n διαφορετικά strings της μορφής "<prefix><i>".
+// Τα strings και ο πίνακας αποδεσμεύονται με την bench_free_strings.
+
+char** bench_create_strings(int n, const char* prefix);
+
+void bench_free_strings(char** strings, int n);
+
+// Ανακατεύει τον πίνακα strings (με σταθερό seed, ώστε να έχουμε τα ίδια αποτελέσματα κάθε φορά)
+
+void bench_shuffle_strings(char** strings, int n);
+
+// Εκτυπώνει μια γραμμή αποτελεσμάτων: όνομα μέτρησης, πλήθος λειτουργιών και χρόνος
+
+void bench_report(const char* name, int ops, double seconds);
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: χτίσιμο ενός map από πίνακες keys/values (πχ φόρτωση
+// ενός snapshot), με map_insert ένα-ένα έναντι map_build_parallel
+// με 1 - 32 threads.
+//
+// Χρήση: ./build_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Χτίζει το map με threads threads (0 για map_insert ένα-ένα) και επιστρέφει τον χρόνο σε δευτερόλεπτα
+
+static double run(Pointer* keys, int n, int threads) {
+	double start = bench_now();
+
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	if (threads == 0) {
+		for (int i = 0; i < n; i++)
+			map_insert(map, keys[i], keys[i]);
+	} else {
+		map_build_parallel(map, keys, keys, n, threads);
+	}
+
+	double seconds = bench_now() - start;
+
+	// Έλεγχος ότι το map περιέχει όλα τα keys
+	if (map_size(map) != n || map_find(map, keys[n / 2]) != keys[n / 2]) {
+		fprintf(stderr, "wrong map with %d threads\n", threads);
+		exit(1);
+	}
+	map_destroy(map);
+	return seconds;
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	// Διαφορετικά keys σε τυχαία σειρά (ο πολλαπλασιασμός με περιττό αριθμό είναι 1-1)
+	int* ints = malloc(n * sizeof(*ints));
+	Pointer* keys = malloc(n * sizeof(*keys));
+	for (int i = 0; i < n; i++) {
+		ints[i] = i * 2654435761u;
+		keys[i] = &ints[i];
+	}
+
+	printf("%d keys, %ld CPUs\n", n, sysconf(_SC_NPROCESSORS_ONLN));
+
+	double sequential = run(keys, n, 0);
+	bench_report("map_insert", n, sequential);
+
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		char name[64];
+		sprintf(name, "map_build_parallel (%d threads)", threads);
+
+		double seconds = run(keys, n, threads);
+		bench_report(name, n, seconds);
+		printf("%-32s %10.2fx speedup\n", "", sequential / seconds);
+	}
+
+	free(keys);
+	free(ints);
+	return 0;
+}
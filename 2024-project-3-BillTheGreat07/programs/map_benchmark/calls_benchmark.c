@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: πόσες φορές καλούνται οι hash_function και compare
+// ανά λειτουργία του map, με string keys.
+//
+// Χρήση: ./calls_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+// Μετρητές κλήσεων, οι οποίοι αυξάνονται από τις παρακάτω συναρτήσεις
+static long hash_calls = 0;
+static long compare_calls = 0;
+
+static uint counting_hash(Pointer value) {
+	hash_calls++;
+	return hash_string(value);
+}
+
+static int counting_compare(Pointer a, Pointer b) {
+	compare_calls++;
+	return strcmp(a, b);
+}
+
+// Εκτυπώνει τα αποτελέσματα μιας φάσης και μηδενίζει τους μετρητές
+static void report(const char* name, int ops, double seconds) {
+	bench_report(name, ops, seconds);
+	printf("%-32s %10.3f hash/op %9.3f compare/op\n", "", (double)hash_calls / ops, (double)compare_calls / ops);
+	hash_calls = 0;
+	compare_calls = 0;
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	char** keys = bench_create_strings(n, "key-");
+	char** missing = bench_create_strings(n, "missing-");
+
+	Map map = map_create(counting_compare, NULL, NULL);
+	map_set_hash_function(map, counting_hash);
+
+	// Εισαγωγή όλων των keys (περιλαμβάνει όλα τα rehash μέχρι το τελικό μέγεθος)
+	double start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_insert(map, keys[i], keys[i]);
+	report("insert", n, bench_now() - start);
+
+	// Οι αναζητήσεις γίνονται με τυχαία σειρά, όχι με τη σειρά εισαγωγής (που ευνοεί το cache)
+	bench_shuffle_strings(keys, n);
+	bench_shuffle_strings(missing, n);
+
+	// Επιτυχημένες αναζητήσεις
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		if (map_find(map, keys[i]) != keys[i])
+			fprintf(stderr, "key %s not found\n", keys[i]);
+	report("find (hit)", n, bench_now() - start);
+
+	// Ανεπιτυχείς αναζητήσεις
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		if (map_find(map, missing[i]) != NULL)
+			fprintf(stderr, "key %s found\n", missing[i]);
+	report("find (miss)", n, bench_now() - start);
+
+	// Διαγραφή όλων των keys
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_remove(map, keys[i]);
+	report("remove", n, bench_now() - start);
+
+	map_destroy(map);
+	bench_free_strings(keys, n);
+	bench_free_strings(missing, n);
+
+	return 0;
+}
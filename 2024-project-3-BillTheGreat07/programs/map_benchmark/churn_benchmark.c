@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: συνεχής εναλλαγή εισαγωγών/διαγραφών (churn) με σταθερό
+// πλήθος στοιχείων. Σε κάθε κύκλο διαγράφεται ένα τυχαίο key, εισάγεται
+// ένα νέο, και γίνεται μία αναζήτηση της οποίας μετράμε τον χρόνο.
+// Ανά παράθυρο κύκλων εκτυπώνεται η μνήμη (RSS) και τα p50/p99 των αναζητήσεων.
+//
+// Χρήση: ./churn_benchmark [στοιχεία] [κύκλοι]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+// Κάθε πόσους κύκλους εκτυπώνουμε αποτελέσματα
+#define WINDOW 100000
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 100000;
+	long cycles = argc > 2 ? atol(argv[2]) : 1000000;
+
+	// Τα keys βρίσκονται στον πίνακα live. Όταν ένα key διαγράφεται, η θέση του παίρνει το επόμενο νέο key,
+	// οπότε το map περιέχει πάντα ακριβώς n στοιχεία, αλλά κάθε key εισάγεται μόνο μία φορά.
+	int* live = malloc(n * sizeof(*live));
+	double* latencies = malloc(WINDOW * sizeof(*latencies));
+
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	int next_key = 0;
+	for (int i = 0; i < n; i++) {
+		live[i] = next_key++;
+		map_insert(map, &live[i], &live[i]);
+	}
+
+	printf("%12s %10s %12s %12s %10s\n", "cycles", "size", "p50 (ns)", "p99 (ns)", "RSS (KB)");
+	srand(0);
+	double start = bench_now();
+	for (long c = 1; c <= cycles; c++) {
+		int slot = ((long)rand() * RAND_MAX + rand()) % n;
+		map_remove(map, &live[slot]);
+		live[slot] = next_key++;
+		map_insert(map, &live[slot], &live[slot]);
+
+		// Αναζήτηση ενός τυχαίου από τα υπάρχοντα keys
+		int* key = &live[((long)rand() * RAND_MAX + rand()) % n];
+		double t = bench_now();
+		if (map_find(map, key) != key)
+			fprintf(stderr, "key %d not found\n", *key);
+		latencies[(c - 1) % WINDOW] = bench_now() - t;
+
+		if (c % WINDOW == 0) {
+			qsort(latencies, WINDOW, sizeof(*latencies), compare_doubles);
+			printf("%12ld %10d %12.1f %12.1f %10ld\n", c, map_size(map),
+				latencies[WINDOW / 2] * 1e9, latencies[WINDOW * 99 / 100] * 1e9, bench_rss_kb());
+		}
+	}
+	bench_report("churn cycle", cycles, bench_now() - start);
+
+	map_destroy(map);
+	free(live);
+	free(latencies);
+
+	return 0;
+}
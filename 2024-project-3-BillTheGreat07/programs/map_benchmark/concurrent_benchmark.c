@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: ρυθμός λειτουργιών με 1 - 64 threads, για μείγματα
+// 95% αναζητήσεις / 5% τροποποιήσεις και 50% / 50%. Συγκρίνεται το
+// ConcurrentMap με ένα Map προστατευμένο από ένα pthread_mutex (το
+// απλούστερο τρόπο να χρησιμοποιηθεί το Map από πολλά threads). Ένα
+// rwlock δε θα αρκούσε: η map_find δε μετακινεί κόμβους, αλλά κατά τη
+// διάρκεια ενός rehash ενημερώνει τα στατιστικά του Map (map_stats).
+//
+// Χρήση: ./concurrent_benchmark [keys] [λειτουργίες]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "ADTMap.h"
+#include "ADTConcurrentMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Τα δεδομένα μιας μέτρησης, κοινά για όλα τα threads
+struct run {
+	bool concurrent;			// ConcurrentMap ή Map + mutex
+	ConcurrentMap concurrent_map;
+	Map map;
+	pthread_mutex_t lock;
+	int* keys;					// Τα keys 0..2*n-1. Τα μισά υπάρχουν κάθε στιγμή στο map (κατά μέσο όρο).
+	int n;
+	int ops;					// Λειτουργίες ανά thread
+	int write_percent;
+};
+
+struct thread_arg {
+	struct run* run;
+	uint seed;
+};
+
+// Γρήγορη γεννήτρια ψευδοτυχαίων αριθμών (xorshift), ξεχωριστή για κάθε thread
+static inline uint next_random(uint* state) {
+	uint x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+static void* thread_main(void* arg) {
+	struct run* run = ((struct thread_arg*)arg)->run;
+	uint seed = ((struct thread_arg*)arg)->seed;
+
+	for (int i = 0; i < run->ops; i++) {
+		uint r = next_random(&seed);
+		int* key = &run->keys[r % (2 * run->n)];
+		bool write = (r >> 24) % 100 < (uint)run->write_percent;
+
+		// Οι τροποποιήσεις είναι μισές εισαγωγές και μισές διαγραφές, ώστε το μέγεθος να μένει σταθερό
+		if (run->concurrent) {
+			if (!write)
+				concurrent_map_find(run->concurrent_map, key);
+			else if (r & 1)
+				concurrent_map_insert(run->concurrent_map, key, key);
+			else
+				concurrent_map_remove(run->concurrent_map, key);
+		} else {
+			pthread_mutex_lock(&run->lock);
+			if (!write)
+				map_find(run->map, key);
+			else if (r & 1)
+				map_insert(run->map, key, key);
+			else
+				map_remove(run->map, key);
+			pthread_mutex_unlock(&run->lock);
+		}
+	}
+	return NULL;
+}
+
+// Εκτελεί total λειτουργίες μοιρασμένες σε threads threads, και επιστρέφει εκατομμύρια λειτουργίες ανά δευτερόλεπτο
+
+static double measure(struct run* run, int threads, int total) {
+	// Το map ξεκινάει με τα μισά keys
+	if (run->concurrent) {
+		run->concurrent_map = concurrent_map_create(compare_ints, hash_int);
+		for (int i = 0; i < run->n; i++)
+			concurrent_map_insert(run->concurrent_map, &run->keys[2 * i], &run->keys[2 * i]);
+	} else {
+		run->map = map_create(compare_ints, NULL, NULL);
+		map_set_hash_function(run->map, hash_int);
+		for (int i = 0; i < run->n; i++)
+			map_insert(run->map, &run->keys[2 * i], &run->keys[2 * i]);
+		pthread_mutex_init(&run->lock, NULL);
+	}
+	run->ops = total / threads;
+
+	pthread_t thread_ids[threads];
+	struct thread_arg args[threads];
+	double start = bench_now();
+	for (int i = 0; i < threads; i++) {
+		args[i].run = run;
+		args[i].seed = 2463534242u + i * 7919u;
+		pthread_create(&thread_ids[i], NULL, thread_main, &args[i]);
+	}
+	for (int i = 0; i < threads; i++)
+		pthread_join(thread_ids[i], NULL);
+	double seconds = bench_now() - start;
+
+	if (run->concurrent) {
+		concurrent_map_destroy(run->concurrent_map);
+	} else {
+		map_destroy(run->map);
+		pthread_mutex_destroy(&run->lock);
+	}
+	return (double)run->ops * threads / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	int total = argc > 2 ? atoi(argv[2]) : 4000000;
+
+	struct run run = { .n = n };
+	run.keys = malloc(2 * n * sizeof(*run.keys));
+	for (int i = 0; i < 2 * n; i++)
+		run.keys[i] = i;
+
+	printf("%d keys, %d ops, %ld CPUs\n", n, total, sysconf(_SC_NPROCESSORS_ONLN));
+	printf("%-8s %8s %16s %16s %10s\n", "mix", "threads", "mutex (Mops/s)", "concurrent", "speedup");
+	int write_percents[] = { 5, 50 };
+	for (int m = 0; m < 2; m++) {
+		run.write_percent = write_percents[m];
+		for (int threads = 1; threads <= 64; threads *= 2) {
+			run.concurrent = false;
+			double locked = measure(&run, threads, total);
+			run.concurrent = true;
+			double concurrent = measure(&run, threads, total);
+
+			printf("%2d/%-5d %8d %16.2f %16.2f %9.2fx\n", 100 - run.write_percent, run.write_percent, threads,
+				locked, concurrent, concurrent / locked);
+		}
+	}
+
+	free(run.keys);
+	return 0;
+}
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: ανάπτυξη ενός map από 0 σε N int keys (πχ 10M). Για κάθε
+// εισαγωγή μετράμε τον χρόνο (p50, p99, p99.9, max), και ανά δεκάδα
+// της εισαγωγής τη μνήμη (RSS). Στο τέλος, το μέγιστο RSS, που
+// δείχνει πόσο κόστισε η ανάπτυξη πέρα από τη μνήμη του τελικού map.
+//
+// Χρήση: ./growth_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	// Τα keys και οι χρόνοι δεσμεύονται (και γράφονται) πριν αρχίσει η μέτρηση, ώστε να μην
+	// επηρεάζουν τη διαφορά του RSS
+	int* keys = malloc(n * sizeof(*keys));
+	double* latencies = malloc(n * sizeof(*latencies));
+	for (int i = 0; i < n; i++) {
+		keys[i] = (int)((unsigned)i * 2654435761u);
+		latencies[i] = 0;
+	}
+	long base_rss = bench_rss_kb();
+
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	printf("%12s %12s\n", "keys", "RSS (KB)");
+	double start = bench_now();
+	for (int i = 0; i < n; i++) {
+		double t = bench_now();
+		map_insert(map, &keys[i], &keys[i]);
+		latencies[i] = bench_now() - t;
+
+		if ((i + 1) % (n / 10) == 0)
+			printf("%12d %12ld\n", i + 1, bench_rss_kb() - base_rss);
+	}
+	double total = bench_now() - start;
+	long final_rss = bench_rss_kb() - base_rss;
+	long peak_rss = bench_peak_rss_kb() - base_rss;
+
+	qsort(latencies, n, sizeof(*latencies), compare_doubles);
+	printf("\n%-8s %10s %10s %10s %12s %10s\n", "insert", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "max (us)", "total (s)");
+	printf("%-8s %10.1f %10.1f %10.1f %12.1f %10.3f\n", "",
+		latencies[n / 2] * 1e9, latencies[(long)n * 99 / 100] * 1e9, latencies[(long)n * 999 / 1000] * 1e9,
+		latencies[n - 1] * 1e6, total);
+	printf("\nfinal RSS: %ld KB, peak RSS: %ld KB (%.2fx)\n", final_rss, peak_rss, (double)peak_rss / final_rss);
+
+	map_destroy(map);
+	free(latencies);
+	free(keys);
+	return 0;
+}
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: οι συναρτήσεις κατακερματισμού της βιβλιοθήκης έναντι
+// των παλιών (djb2, identity, cast του pointer), σε διάφορες
+// κατανομές keys. Για κάθε κατανομή μετράμε:
+// - ταχύτητα της συνάρτησης (ns/hash)
+// - μέσο μήκος αναζήτησης σε linear probing με load factor 0.5,
+//   για keys που υπάρχουν (hit) και που δεν υπάρχουν (miss)
+// - χρόνο εισαγωγής και αναζήτησης όλων των keys (με τυχαία σειρά) σε ένα Map
+//
+// Χρήση: ./hash_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+// Οι παλιές συναρτήσεις κατακερματισμού
+
+static uint old_hash_string(Pointer value) {
+	uint hash = 5381;
+	for (char* s = value; *s != '\0'; s++)
+		hash = (hash << 5) + hash + *s;
+	return hash;
+}
+
+static uint old_hash_int(Pointer value) {
+	return *(int*)value;
+}
+
+static uint old_hash_pointer(Pointer value) {
+	return (size_t)value;
+}
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_strings(Pointer a, Pointer b) {
+	return strcmp(a, b);
+}
+
+static int compare_pointers(Pointer a, Pointer b) {
+	return (char*)a - (char*)b;
+}
+
+// Μια κατανομή keys, με τις συναρτήσεις που της αντιστοιχούν
+
+typedef struct {
+	const char* name;
+	Pointer* keys;
+	CompareFunc compare;
+	HashFunc old_hash;
+	HashFunc new_hash;
+} Distribution;
+
+static bool is_prime(int n) {
+	for (int d = 2; d * d <= n; d++)
+		if (n % d == 0)
+			return false;
+	return n > 1;
+}
+
+// Προσομοίωση linear probing σε πίνακα με πρώτο μέγεθος (όπως το Map) και load factor 0.5.
+// Υπολογίζει το μέσο πλήθος κελιών που εξετάζει μια επιτυχής (hit) και μια ανεπιτυχής (miss) αναζήτηση.
+
+static void probe_lengths(Pointer* keys, int n, HashFunc hash, double* hit, double* miss) {
+	int capacity = 2 * n + 1;
+	while (!is_prime(capacity))
+		capacity++;
+
+	bool* occupied = calloc(capacity, sizeof(*occupied));
+	long total = 0;
+	for (int i = 0; i < n; i++) {
+		int pos = hash(keys[i]) % capacity;
+		int probes = 1;
+		for (; occupied[pos]; probes++)
+			pos = pos + 1 == capacity ? 0 : pos + 1;
+		occupied[pos] = true;
+		total += probes;
+	}
+	*hit = (double)total / n;
+
+	// Μια αναζήτηση που δεν πετυχαίνει, με τυχαία αρχική θέση, εξετάζει όλα τα κελιά μέχρι το επόμενο κενό.
+	// Υπολογίζουμε την απόσταση από κάθε θέση μέχρι το επόμενο κενό, ξεκινώντας από το τέλος.
+	int first_empty = 0;
+	while (occupied[first_empty])
+		first_empty++;
+
+	long run = 0;
+	total = 0;
+	for (int i = 0, pos = first_empty; i < capacity; i++) {
+		run = occupied[pos] ? run + 1 : 0;
+		total += run + 1;
+		pos = pos == 0 ? capacity - 1 : pos - 1;
+	}
+	*miss = (double)total / capacity;
+
+	free(occupied);
+}
+
+// Χρόνος για hash όλων των keys (ns/hash)
+
+static double hash_time(Pointer* keys, int n, HashFunc hash) {
+	// Επαναλήψεις ώστε να έχουμε αξιόπιστη μέτρηση και για γρήγορες συναρτήσεις
+	int rounds = 10;
+	volatile uint sink = 0;
+	double start = bench_now();
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < n; i++)
+			sink += hash(keys[i]);
+	return (bench_now() - start) * 1e9 / ((double)rounds * n);
+}
+
+// Χρόνος εισαγωγής και αναζήτησης όλων των keys σε ένα Map (ns/op)
+
+static void map_time(Distribution* dist, int n, HashFunc hash, double* insert, double* find) {
+	Map map = map_create(dist->compare, NULL, NULL);
+	map_set_hash_function(map, hash);
+
+	double start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_insert(map, dist->keys[i], dist->keys[i]);
+	*insert = (bench_now() - start) * 1e9 / n;
+
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		if (map_find(map, dist->keys[i]) != dist->keys[i])
+			printf("error: key not found\n");
+	*find = (bench_now() - start) * 1e9 / n;
+
+	map_destroy(map);
+}
+
+static void run(Distribution* dist, int n) {
+	HashFunc hashes[2] = { dist->old_hash, dist->new_hash };
+	const char* names[2] = { "old", "new" };
+
+	for (int h = 0; h < 2; h++) {
+		double hit, miss, insert, find;
+		probe_lengths(dist->keys, n, hashes[h], &hit, &miss);
+		map_time(dist, n, hashes[h], &insert, &find);
+
+		printf("%-20s %-4s %8.1f ns/hash %8.2f hit probes %10.2f miss probes %8.1f ns/insert %8.1f ns/find\n",
+			dist->name, names[h], hash_time(dist->keys, n, hashes[h]), hit, miss, insert, find);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	int* ints = malloc(n * sizeof(*ints));
+	int* strided = malloc(n * sizeof(*strided));
+	Pointer* int_keys = malloc(n * sizeof(*int_keys));
+	Pointer* strided_keys = malloc(n * sizeof(*strided_keys));
+	Pointer* pointer_keys = malloc(n * sizeof(*pointer_keys));
+	for (int i = 0; i < n; i++) {
+		ints[i] = i;									// πχ ids από μια βάση δεδομένων
+		strided[i] = i * 1024;							// πχ offsets σε αρχείο
+		int_keys[i] = &ints[i];
+		strided_keys[i] = &strided[i];
+		pointer_keys[i] = malloc(32);					// πχ ένα map από αντικείμενα
+	}
+
+	// Strings: σύντομα ονόματα χρηστών, και μακριά URLs με κοινό πρόθεμα
+	char** short_strings = bench_create_strings(n, "user_");
+	char** long_strings = bench_create_strings(n, "https://www.example.com/products/category/item?id=");
+
+	Distribution distributions[] = {
+		{ "sequential ints",	int_keys,				compare_ints,		old_hash_int,		hash_int },
+		{ "strided ints",		strided_keys,			compare_ints,		old_hash_int,		hash_int },
+		{ "heap pointers",		pointer_keys,			compare_pointers,	old_hash_pointer,	hash_pointer },
+		{ "short strings",		(Pointer*)short_strings,	compare_strings,	old_hash_string,	hash_string },
+		{ "long strings (URLs)",	(Pointer*)long_strings,	compare_strings,	old_hash_string,	hash_string },
+	};
+	for (int i = 0; i < (int)(sizeof(distributions) / sizeof(distributions[0])); i++) {
+		// Τα keys δεν έρχονται ταξινομημένα, αλλιώς διαδοχικές λειτουργίες θα πηγαίναν σε γειτονικά κελιά
+		bench_shuffle_strings((char**)distributions[i].keys, n);
+		run(&distributions[i], n);
+	}
+
+	for (int i = 0; i < n; i++)
+		free(pointer_keys[i]);
+	free(ints);
+	free(strided);
+	free(int_keys);
+	free(strided_keys);
+	free(pointer_keys);
+	bench_free_strings(short_strings, n);
+	bench_free_strings(long_strings, n);
+	return 0;
+}
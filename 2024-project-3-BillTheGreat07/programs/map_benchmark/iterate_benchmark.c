@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: μνήμη και χρόνος διάσχισης ενός map, γεμάτου και
+// αραιού (μετά από διαγραφή των περισσότερων στοιχείων).
+//
+// Χρήση: ./iterate_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Διασχίζει το map rounds φορές, και τυπώνει τον χρόνο ανά στοιχείο
+
+static void iterate(Map map, int rounds, const char* name) {
+	long sum = 0;
+	double start = bench_now();
+	for (int r = 0; r < rounds; r++)
+		for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node))
+			sum += *(int*)map_node_value(map, node);
+	double seconds = bench_now() - start;
+
+	bench_report(name, rounds * map_size(map), seconds);
+	if (sum == 42) printf("\n");			// ώστε ο compiler να μην αφαιρέσει το loop
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	int* keys = malloc(n * sizeof(*keys));
+	for (int i = 0; i < n; i++)
+		keys[i] = (int)((unsigned)i * 2654435761u);
+
+	long rss = bench_rss_kb();
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	for (int i = 0; i < n; i++)
+		map_insert(map, &keys[i], &keys[i]);
+	printf("%-32s %10ld KB (%.1f bytes/entry)\n", "map memory", bench_rss_kb() - rss, (bench_rss_kb() - rss) * 1024.0 / n);
+
+	iterate(map, 10, "iterate full map");
+
+	// Διαγραφή του 99% των στοιχείων
+	for (int i = 0; i < n; i++)
+		if (i % 100 != 0)
+			map_remove(map, &keys[i]);
+
+	iterate(map, 1000, "iterate after removing 99%");
+
+	map_destroy(map);
+	free(keys);
+	return 0;
+}
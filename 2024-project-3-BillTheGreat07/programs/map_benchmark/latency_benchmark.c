@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: κατανομή του χρόνου κάθε εισαγωγής (p50, p99, p99.9, max),
+// με το κανονικό incremental rehash και με background rehash.
+//
+// Χρήση: ./latency_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+static void run(int* keys, int n, bool background, const char* name) {
+	double* latencies = malloc(n * sizeof(*latencies));
+
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	map_set_background_rehash(map, background);
+
+	double start = bench_now();
+	for (int i = 0; i < n; i++) {
+		double t = bench_now();
+		map_insert(map, &keys[i], &keys[i]);
+		latencies[i] = bench_now() - t;
+	}
+	double total = bench_now() - start;
+
+	qsort(latencies, n, sizeof(*latencies), compare_doubles);
+	printf("%-12s %10.1f %10.1f %10.1f %12.1f %10.3f\n", name,
+		latencies[n / 2] * 1e9, latencies[(long)n * 99 / 100] * 1e9, latencies[(long)n * 999 / 1000] * 1e9,
+		latencies[n - 1] * 1e6, total);
+
+	map_destroy(map);
+	free(latencies);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	int* keys = malloc(n * sizeof(*keys));
+	for (int i = 0; i < n; i++)
+		keys[i] = i;
+
+	printf("%-12s %10s %10s %10s %12s %10s\n", "insert", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "max (us)", "total (s)");
+	run(keys, n, false, "incremental");
+	run(keys, n, true, "background");
+
+	free(keys);
+	return 0;
+}
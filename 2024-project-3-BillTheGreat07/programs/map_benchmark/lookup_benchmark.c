@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: κατανομή του χρόνου κάθε αναζήτησης (p50, p99, p99.9, max)
+// σε map με N int keys, για keys που υπάρχουν και keys που δεν υπάρχουν,
+// με τυχαία σειρά. Για σύγκριση των υλοποιήσεων (πχ linear probing
+// έναντι cuckoo hashing) στη χειρότερη περίπτωση και όχι μόνο στη μέση.
+//
+// Χρήση: ./lookup_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+// Διαφορετικά μεταξύ τους keys, "σκορπισμένα" ώστε να μην ευνοείται καμία υλοποίηση από διαδοχικά hash codes
+// (ο πολλαπλασιασμός με περιττό αριθμό είναι 1-1 στους 32 bit αριθμούς)
+
+static int* scattered_keys(int n) {
+	int* keys = malloc(n * sizeof(*keys));
+	for (int i = 0; i < n; i++)
+		keys[i] = (int)((unsigned)i * 2654435761u);
+	return keys;
+}
+
+// Ανακατεύει τον πίνακα (με σταθερό seed)
+
+static void shuffle(int* keys, int n) {
+	srand(0);
+	for (int i = n - 1; i > 0; i--) {
+		int j = ((long)rand() * RAND_MAX + rand()) % (i + 1);
+		int temp = keys[i];
+		keys[i] = keys[j];
+		keys[j] = temp;
+	}
+}
+
+static void run(Map map, int* keys, int n, const char* name) {
+	double* latencies = malloc(n * sizeof(*latencies));
+
+	int found = 0;
+	double start = bench_now();
+	for (int i = 0; i < n; i++) {
+		double t = bench_now();
+		found += map_find(map, &keys[i]) != NULL;
+		latencies[i] = bench_now() - t;
+	}
+	double total = bench_now() - start;
+
+	qsort(latencies, n, sizeof(*latencies), compare_doubles);
+	printf("%-8s %10.1f %10.1f %10.1f %12.1f %10.3f %8d\n", name,
+		latencies[n / 2] * 1e9, latencies[(long)n * 99 / 100] * 1e9, latencies[(long)n * 999 / 1000] * 1e9,
+		latencies[n - 1] * 1e6, total, found);
+
+	free(latencies);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	// Τα πρώτα n keys μπαίνουν στο map, τα υπόλοιπα n χρησιμοποιούνται για αποτυχημένες αναζητήσεις
+	int* keys = scattered_keys(2 * n);
+
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	for (int i = 0; i < n; i++)
+		map_insert(map, &keys[i], &keys[i]);
+
+	// Αντίγραφα των keys σε άλλη σειρά (και σε άλλη θέση μνήμης από αυτά που είναι στο map)
+	int* hits = malloc(n * sizeof(*hits));
+	int* misses = malloc(n * sizeof(*misses));
+	for (int i = 0; i < n; i++) {
+		hits[i] = keys[i];
+		misses[i] = keys[n + i];
+	}
+	shuffle(hits, n);
+	shuffle(misses, n);
+
+	printf("%-8s %10s %10s %10s %12s %10s %8s\n", "find", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "max (us)", "total (s)", "found");
+	run(map, hits, n, "hit");
+	run(map, misses, n, "miss");
+	printf("RSS: %ld KB\n", bench_rss_kb());
+
+	map_destroy(map);
+	free(hits);
+	free(misses);
+	free(keys);
+	return 0;
+}
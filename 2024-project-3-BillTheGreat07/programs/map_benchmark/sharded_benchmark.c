@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: παράλληλη μέτρηση (πόσες φορές εμφανίζεται κάθε key)
+// με 1 - 64 threads. Συγκρίνονται:
+// - ένα Map προστατευμένο από ένα pthread_mutex (map_update)
+// - ένα κοινό ShardedMap με lock ανά shard (sharded_map_update)
+// - ένα ShardedMap χωρίς locks ανά thread, τα οποία στο τέλος
+//   συγχωνεύονται (sharded_map_merge) και μεταφέρονται σε ένα Map
+//   (sharded_map_merge_into)
+// Σε όλες τις περιπτώσεις το αποτέλεσμα είναι ένα Map, και ελέγχεται.
+//
+// Χρήση: ./sharded_benchmark [λειτουργίες] [διαφορετικά keys]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "ADTMap.h"
+#include "ADTShardedMap.h"
+#include "benchmark.h"
+
+#define SHARDS 64
+
+enum mode { GLOBAL_LOCK, LOCKED_SHARDS, MERGED_SHARDS };
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Οι μετρητές αποθηκεύονται απευθείας μέσα στον Pointer του value
+
+static Pointer increment(Pointer value) {
+	return (Pointer)((intptr_t)value + 1);
+}
+
+static Pointer add(Pointer target_value, Pointer source_value) {
+	return (Pointer)((intptr_t)target_value + (intptr_t)source_value);
+}
+
+// Τα δεδομένα μιας μέτρησης, κοινά για όλα τα threads
+struct run {
+	enum mode mode;
+	Map map;					// GLOBAL_LOCK
+	pthread_mutex_t lock;
+	ShardedMap shared;			// LOCKED_SHARDS, και το target του MERGED_SHARDS
+	int* keys;					// Τα keys 0..k-1
+	int k;
+	int ops;					// Λειτουργίες ανά thread
+};
+
+struct thread_arg {
+	struct run* run;
+	uint seed;
+};
+
+// Γρήγορη γεννήτρια ψευδοτυχαίων αριθμών (xorshift), ξεχωριστή για κάθε thread
+static inline uint next_random(uint* state) {
+	uint x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+static void* thread_main(void* arg) {
+	struct run* run = ((struct thread_arg*)arg)->run;
+	uint seed = ((struct thread_arg*)arg)->seed;
+
+	ShardedMap local = run->mode == MERGED_SHARDS
+		? sharded_map_create(SHARDS, false, compare_ints, hash_int, NULL, NULL)
+		: NULL;
+
+	for (int i = 0; i < run->ops; i++) {
+		int* key = &run->keys[next_random(&seed) % run->k];
+
+		if (run->mode == GLOBAL_LOCK) {
+			pthread_mutex_lock(&run->lock);
+			map_update(run->map, key, increment);
+			pthread_mutex_unlock(&run->lock);
+		} else if (run->mode == LOCKED_SHARDS) {
+			sharded_map_update(run->shared, key, increment);
+		} else {
+			sharded_map_update(local, key, increment);
+		}
+	}
+
+	if (local != NULL) {
+		sharded_map_merge(run->shared, local, add);
+		sharded_map_destroy(local);
+	}
+	return NULL;
+}
+
+// Εκτελεί total λειτουργίες μοιρασμένες σε threads threads, και επιστρέφει εκατομμύρια λειτουργίες ανά δευτερόλεπτο
+// (συμπεριλαμβανομένης της συγχώνευσης σε ένα τελικό Map)
+
+static double measure(struct run* run, int threads, int total) {
+	run->ops = total / threads;
+	if (run->mode == GLOBAL_LOCK) {
+		pthread_mutex_init(&run->lock, NULL);
+	} else {
+		run->shared = sharded_map_create(SHARDS, true, compare_ints, hash_int, NULL, NULL);
+	}
+
+	pthread_t thread_ids[threads];
+	struct thread_arg args[threads];
+	double start = bench_now();
+
+	Map result = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(result, hash_int);
+	if (run->mode == GLOBAL_LOCK)
+		run->map = result;
+
+	for (int i = 0; i < threads; i++) {
+		args[i].run = run;
+		args[i].seed = 2463534242u + i * 7919u;
+		pthread_create(&thread_ids[i], NULL, thread_main, &args[i]);
+	}
+	for (int i = 0; i < threads; i++)
+		pthread_join(thread_ids[i], NULL);
+
+	if (run->mode != GLOBAL_LOCK)
+		sharded_map_merge_into(run->shared, result, NULL);
+
+	double seconds = bench_now() - start;
+
+	// Έλεγχος: το άθροισμα όλων των μετρητών είναι το πλήθος των λειτουργιών
+	long sum = 0;
+	for (MapNode node = map_first(result); node != MAP_EOF; node = map_next(result, node))
+		sum += (intptr_t)map_node_value(result, node);
+	if (sum != (long)run->ops * threads) {
+		fprintf(stderr, "wrong total: %ld != %ld\n", sum, (long)run->ops * threads);
+		exit(1);
+	}
+
+	map_destroy(result);
+	if (run->mode == GLOBAL_LOCK)
+		pthread_mutex_destroy(&run->lock);
+	else
+		sharded_map_destroy(run->shared);
+
+	return (double)run->ops * threads / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+	int total = argc > 1 ? atoi(argv[1]) : 4000000;
+	int k = argc > 2 ? atoi(argv[2]) : 100000;
+
+	struct run run = { .k = k };
+	run.keys = malloc(k * sizeof(*run.keys));
+	for (int i = 0; i < k; i++)
+		run.keys[i] = i;
+
+	printf("%d ops, %d keys, %d shards, %ld CPUs (Mops/s)\n", total, k, SHARDS, sysconf(_SC_NPROCESSORS_ONLN));
+	printf("%8s %14s %14s %14s\n", "threads", "global lock", "locked shards", "merged shards");
+	for (int threads = 1; threads <= 64; threads *= 2) {
+		double results[3];
+		for (int mode = GLOBAL_LOCK; mode <= MERGED_SHARDS; mode++) {
+			run.mode = mode;
+			results[mode] = measure(&run, threads, total);
+		}
+		printf("%8d %14.2f %14.2f %14.2f\n", threads, results[GLOBAL_LOCK], results[LOCKED_SHARDS], results[MERGED_SHARDS]);
+	}
+
+	free(run.keys);
+	return 0;
+}
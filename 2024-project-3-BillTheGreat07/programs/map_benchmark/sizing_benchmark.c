@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: μεγέθη πίνακα πρώτοι αριθμοί (hash % capacity) έναντι
+// δυνάμεων του 2 (Fibonacci hashing + mask), με int keys.
+//
+// Χρήση: ./sizing_benchmark [N ...]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Εκτελεί insert/find για n keys, με τον συγκεκριμένο τρόπο επιλογής μεγέθους, και αν with_misses
+// επιπλέον n ανεπιτυχείς αναζητήσεις.
+static void run(int* keys, int n, MapSizing sizing, const char* name, bool with_misses) {
+	char title[64];
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+	map_set_sizing(map, sizing);
+
+	double start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_insert(map, &keys[i], &keys[i]);
+	snprintf(title, sizeof(title), "%s insert", name);
+	bench_report(title, n, bench_now() - start);
+
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		if (map_find(map, &keys[i]) == NULL)				// τα τυχαία keys μπορεί να επαναλαμβάνονται
+			fprintf(stderr, "key %d not found\n", keys[i]);
+	snprintf(title, sizeof(title), "%s find (hit)", name);
+	bench_report(title, n, bench_now() - start);
+
+	// Τα keys είναι στο [0, 2n), οπότε τα αρνητικά σίγουρα δεν υπάρχουν
+	if (!with_misses) {
+		map_destroy(map);
+		return;
+	}
+	start = bench_now();
+	for (int i = 0; i < n; i++) {
+		int missing = -keys[i] - 1;
+		if (map_find(map, &missing) != NULL)
+			fprintf(stderr, "key %d found\n", missing);
+	}
+	snprintf(title, sizeof(title), "%s find (miss)", name);
+	bench_report(title, n, bench_now() - start);
+
+	map_destroy(map);
+}
+
+int main(int argc, char* argv[]) {
+	int sizes_no = argc > 1 ? argc - 1 : 1;
+	for (int s = 0; s < sizes_no; s++) {
+		int n = argc > 1 ? atoi(argv[s + 1]) : 1000000;
+
+		// Διαδοχικά keys (το χειρότερο σενάριο για ένα identity hash)
+		// και τυχαία keys στο [0, 2n), σε τυχαία σειρά.
+		int* sequential = malloc(n * sizeof(*sequential));
+		int* random = malloc(n * sizeof(*random));
+		srand(0);
+		for (int i = 0; i < n; i++) {
+			sequential[i] = i;
+			random[i] = (int)(((long)rand() * RAND_MAX + rand()) % (2L * n));
+		}
+
+		// Με διαδοχικά keys και hash % capacity, όλα τα keys σχηματίζουν ένα ενιαίο cluster μήκους n,
+		// οπότε κάθε ανεπιτυχής αναζήτηση που πέφτει μέσα του κοστίζει O(n). Τις μετράμε μόνο στα τυχαία keys.
+		printf("N = %d, sequential keys\n", n);
+		run(sequential, n, MAP_SIZE_PRIME, "prime", false);
+		run(sequential, n, MAP_SIZE_POWER_OF_TWO, "pow2", false);
+
+		printf("N = %d, random keys\n", n);
+		run(random, n, MAP_SIZE_PRIME, "prime", true);
+		run(random, n, MAP_SIZE_POWER_OF_TWO, "pow2", true);
+
+		free(sequential);
+		free(random);
+	}
+
+	return 0;
+}
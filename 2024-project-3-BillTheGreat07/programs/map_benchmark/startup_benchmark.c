@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: μαζική εισαγωγή γνωστού πλήθους keys (πχ κατά την
+// εκκίνηση μιας εφαρμογής), με και χωρίς map_create_with_capacity.
+//
+// Χρήση: ./startup_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static void run(int* keys, int n, bool presized, const char* name) {
+	double start = bench_now();
+
+	Map map = presized
+		? map_create_with_capacity(compare_ints, NULL, NULL, n)
+		: map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	for (int i = 0; i < n; i++)
+		map_insert(map, &keys[i], &keys[i]);
+
+	double seconds = bench_now() - start;
+	bench_report(name, n, seconds);
+	printf("%-32s %10d grows %9ld RSS (KB)\n", "", map_stats(map).grows, bench_rss_kb());
+
+	map_destroy(map);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	int* keys = malloc(n * sizeof(*keys));
+	srand(0);
+	for (int i = 0; i < n; i++)
+		keys[i] = (long)rand() * RAND_MAX + rand();
+
+	run(keys, n, false, "map_create + insert");
+	run(keys, n, true, "map_create_with_capacity + insert");
+
+	free(keys);
+	return 0;
+}
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: typed maps (DEFINE_MAP, keys/values μέσα στους κόμβους,
+// inline hash/σύγκριση) έναντι του γενικού ADT Map (Pointer keys,
+// function pointers, ή inline αποθήκευση), για int => int και string => int.
+//
+// Χρήση: ./typed_benchmark [N]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ADTMap.h"
+#include "ADTTypedMap.h"
+#include "benchmark.h"
+
+
+DEFINE_MAP(IntIntMap, int, int, typed_map_hash_int, typed_map_equal_int)
+DEFINE_MAP(StringIntMap, const char*, int, typed_map_hash_string, typed_map_equal_string)
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+static int compare_strings(Pointer a, Pointer b) {
+	return strcmp(a, b);
+}
+
+// "Τυχαία" σειρά των αριθμών 0..n-1 (με σταθερό seed)
+
+static int* shuffled_indices(int n) {
+	int* order = malloc(n * sizeof(*order));
+	for (int i = 0; i < n; i++)
+		order[i] = i;
+	srand(0);
+	for (int i = n - 1; i > 0; i--) {
+		int j = ((long)rand() * RAND_MAX + rand()) % (i + 1);
+		int temp = order[i];
+		order[i] = order[j];
+		order[j] = temp;
+	}
+	return order;
+}
+
+// int => int. Στο γενικό Map κάθε key και value δεσμεύεται χωριστά (όπως το create_int των tests).
+
+static int int_key(int i) {
+	return (int)((unsigned)i * 2654435761u);
+}
+
+static void generic_ints(int n, int* order) {
+	double start = bench_now();
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+	for (int i = 0; i < n; i++) {
+		int* key = malloc(sizeof(*key));
+		int* value = malloc(sizeof(*value));
+		*key = int_key(i);
+		*value = i;
+		map_insert(map, key, value);
+	}
+	bench_report("int: Map insert", n, bench_now() - start);
+	printf("%-32s %10ld RSS (KB)\n", "", bench_rss_kb());
+
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++) {
+		int key = int_key(order[i]);
+		errors += *(int*)map_find(map, &key) != order[i];
+	}
+	bench_report("int: Map find", n, bench_now() - start);
+
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	map_destroy(map);
+}
+
+// Το ίδιο με inline αποθήκευση (map_create_inline): το map αντιγράφει keys/values στον πίνακά του
+
+static void inline_ints(int n, int* order) {
+	double start = bench_now();
+	Map map = map_create_inline(sizeof(int), sizeof(int), compare_ints);
+	map_set_hash_function(map, hash_int);
+	for (int i = 0; i < n; i++) {
+		int key = int_key(i);
+		map_insert(map, &key, &i);
+	}
+	bench_report("int: inline Map insert", n, bench_now() - start);
+	printf("%-32s %10ld RSS (KB)\n", "", bench_rss_kb());
+
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++) {
+		int key = int_key(order[i]);
+		errors += *(int*)map_find(map, &key) != order[i];
+	}
+	bench_report("int: inline Map find", n, bench_now() - start);
+
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	map_destroy(map);
+}
+
+static void typed_ints(int n, int* order) {
+	double start = bench_now();
+	IntIntMap* map = IntIntMap_create();
+	for (int i = 0; i < n; i++)
+		IntIntMap_insert(map, int_key(i), i);
+	bench_report("int: IntIntMap insert", n, bench_now() - start);
+	printf("%-32s %10ld RSS (KB)\n", "", bench_rss_kb());
+
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		errors += *IntIntMap_find(map, int_key(order[i])) != order[i];
+	bench_report("int: IntIntMap find", n, bench_now() - start);
+
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	IntIntMap_destroy(map);
+}
+
+// string => int. Τα strings ανήκουν στον caller και στις δύο περιπτώσεις, το value του γενικού
+// Map αποθηκεύεται απευθείας μέσα στον Pointer.
+
+static void generic_strings(int n, int* order) {
+	char** keys = bench_create_strings(n, "key_");
+
+	double start = bench_now();
+	Map map = map_create(compare_strings, NULL, NULL);
+	map_set_hash_function(map, hash_string);
+	for (int i = 0; i < n; i++)
+		map_insert(map, keys[i], (Pointer)(intptr_t)i);
+	bench_report("string: Map insert", n, bench_now() - start);
+
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		errors += (intptr_t)map_find(map, keys[order[i]]) != order[i];
+	bench_report("string: Map find", n, bench_now() - start);
+
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	map_destroy(map);
+	bench_free_strings(keys, n);
+}
+
+static void typed_strings(int n, int* order) {
+	char** keys = bench_create_strings(n, "key_");
+
+	double start = bench_now();
+	StringIntMap* map = StringIntMap_create();
+	for (int i = 0; i < n; i++)
+		StringIntMap_insert(map, keys[i], i);
+	bench_report("string: StringIntMap insert", n, bench_now() - start);
+
+	int errors = 0;
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		errors += *StringIntMap_find(map, keys[order[i]]) != order[i];
+	bench_report("string: StringIntMap find", n, bench_now() - start);
+
+	if (errors != 0)
+		printf("ERROR: %d wrong values\n", errors);
+	StringIntMap_destroy(map);
+	bench_free_strings(keys, n);
+}
+
+// Εκτελεί τη μέτρηση σε ξεχωριστή διεργασία, ώστε η μνήμη που αποδέσμευσαν οι προηγούμενες μετρήσεις
+// (εκατομμύρια μικρά blocks του γενικού Map) να μην επηρεάζει τον χρόνο ή το RSS της επόμενης.
+
+static void run(void (*benchmark)(int, int*), int n, int* order) {
+	fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0) {
+		benchmark(n, order);
+		exit(0);
+	}
+	waitpid(pid, NULL, 0);
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	// Οι αναζητήσεις γίνονται με τυχαία σειρά, ώστε να μην ευνοούνται από τη σειρά εισαγωγής
+	int* order = shuffled_indices(n);
+	run(generic_ints, n, order);
+	run(inline_ints, n, order);
+	run(typed_ints, n, order);
+	run(generic_strings, n, order);
+	run(typed_strings, n, order);
+
+	free(order);
+	return 0;
+}
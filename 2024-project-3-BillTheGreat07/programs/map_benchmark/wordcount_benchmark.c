@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////
+//
+// Benchmark: μέτρηση εμφανίσεων λέξεων (word count), με
+// map_find + map_insert έναντι map_find_or_insert και map_update.
+//
+// Χρήση: ./wordcount_benchmark [WORDS] [DISTINCT]
+//
+///////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ADTMap.h"
+#include "benchmark.h"
+
+
+// Τα πλήθη αποθηκεύονται απευθείας μέσα στον Pointer (πλήθος 0 = NULL = η λέξη δεν υπάρχει),
+// ώστε να μετράμε μόνο το κόστος του map και όχι δεσμεύσεις μνήμης.
+#define COUNT(value) ((intptr_t)(value))
+#define VALUE(count) ((Pointer)(intptr_t)(count))
+
+static int compare_strings(Pointer a, Pointer b) {
+	return strcmp(a, b);
+}
+
+static Pointer increment(Pointer value) {
+	return VALUE(COUNT(value) + 1);
+}
+
+static Map create_counts(void) {
+	Map map = map_create(compare_strings, NULL, NULL);
+	map_set_hash_function(map, hash_string);
+	return map;
+}
+
+// Επιστρέφει το άθροισμα όλων των πληθών (πρέπει να ισούται με το πλήθος των λέξεων)
+
+static long total(Map map) {
+	long sum = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node))
+		sum += COUNT(map_node_value(map, node));
+	return sum;
+}
+
+int main(int argc, char* argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 10000000;
+	int distinct = argc > 2 ? atoi(argv[2]) : 100000;
+
+	// Το "κείμενο": n λέξεις, επιλεγμένες τυχαία από distinct διαφορετικές. Κάθε λέξη του κειμένου είναι
+	// ξεχωριστό αντίγραφο (όπως αν διαβαζόταν από αρχείο), οπότε το map δεν μπορεί να συγκρίνει pointers.
+	char** vocabulary = bench_create_strings(distinct, "word_");
+	char** words = malloc(n * sizeof(*words));
+	char* text = malloc(n * 16);
+	srand(0);
+	for (int i = 0; i < n; i++) {
+		words[i] = &text[i * 16];
+		strcpy(words[i], vocabulary[rand() % distinct]);
+	}
+
+	// map_find + map_insert: δύο hashes και δύο αναζητήσεις για κάθε λέξη
+	Map map = create_counts();
+	double start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_insert(map, words[i], increment(map_find(map, words[i])));
+	bench_report("map_find + map_insert", n, bench_now() - start);
+	if (total(map) != n) printf("error: wrong counts\n");
+	map_destroy(map);
+
+	// map_find_or_insert: ένα hash και μία αναζήτηση, η τιμή γράφεται κατευθείαν στον κόμβο
+	map = create_counts();
+	start = bench_now();
+	for (int i = 0; i < n; i++) {
+		MapNode node = map_find_or_insert(map, words[i], NULL);
+		map_node_set_value(map, node, increment(map_node_value(map, node)));
+	}
+	bench_report("map_find_or_insert", n, bench_now() - start);
+	if (total(map) != n) printf("error: wrong counts\n");
+	map_destroy(map);
+
+	// map_update
+	map = create_counts();
+	start = bench_now();
+	for (int i = 0; i < n; i++)
+		map_update(map, words[i], increment);
+	bench_report("map_update", n, bench_now() - start);
+	if (total(map) != n) printf("error: wrong counts\n");
+	map_destroy(map);
+
+	free(text);
+	free(words);
+	bench_free_strings(vocabulary, distinct);
+	return 0;
+}
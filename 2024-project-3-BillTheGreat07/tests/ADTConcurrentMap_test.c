@@ -0,0 +1,229 @@
+//////////////////////////////////////////////////////////////////
+//
+// Unit tests για τον ADT ConcurrentMap.
+// Οποιαδήποτε υλοποίηση οφείλει να περνάει όλα τα tests.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "acutest.h"			// Απλή βιβλιοθήκη για unit testing
+
+#include "ADTConcurrentMap.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Πίνακας με τους αριθμούς 0..n-1, που χρησιμοποιούνται ως keys και values
+static int* create_ints(int n) {
+	int* array = malloc(n * sizeof(*array));
+	for (int i = 0; i < n; i++)
+		array[i] = i;
+	return array;
+}
+
+
+void test_create(void) {
+	ConcurrentMap map = concurrent_map_create(compare_ints, hash_int);
+	TEST_ASSERT(map != NULL);
+	TEST_ASSERT(concurrent_map_size(map) == 0);
+
+	int key = 0;
+	TEST_ASSERT(concurrent_map_find(map, &key) == NULL);
+	TEST_ASSERT(!concurrent_map_remove(map, &key));
+
+	concurrent_map_destroy(map);
+}
+
+void test_insert_find_remove(void) {
+	ConcurrentMap map = concurrent_map_create(compare_ints, hash_int);
+
+	// Αρκετά keys ώστε να γίνουν πολλά incremental rehash σε κάθε stripe, τα οποία ελέγχουμε ενδιάμεσα
+	int N = 100000;
+	int* ints = create_ints(2 * N);
+	for (int i = 0; i < N; i++) {
+		concurrent_map_insert(map, &ints[i], &ints[i]);
+		TEST_ASSERT(concurrent_map_size(map) == i + 1);
+		TEST_ASSERT(concurrent_map_find(map, &ints[i]) == &ints[i]);
+		TEST_ASSERT(concurrent_map_find(map, &ints[i / 2]) == &ints[i / 2]);
+	}
+	TEST_ASSERT(concurrent_map_find(map, &ints[N]) == NULL);
+
+	// Αντικατάσταση με ισοδύναμο key
+	int key = 7;
+	concurrent_map_insert(map, &key, &ints[N]);
+	TEST_ASSERT(concurrent_map_size(map) == N);
+	TEST_ASSERT(concurrent_map_find(map, &ints[7]) == &ints[N]);
+
+	// Διαγραφή των μισών, και εισαγωγή νέων (που καταλαμβάνουν DELETED κελιά ή προκαλούν rehash)
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(concurrent_map_remove(map, &ints[i]));
+	TEST_ASSERT(!concurrent_map_remove(map, &ints[0]));
+	TEST_ASSERT(concurrent_map_size(map) == N / 2);
+
+	for (int i = N; i < 2 * N; i++)
+		concurrent_map_insert(map, &ints[i], &ints[i]);
+	TEST_ASSERT(concurrent_map_size(map) == N / 2 + N);
+
+	for (int i = 0; i < 2 * N; i++) {
+		Pointer value = concurrent_map_find(map, &ints[i]);
+		if (i < N && i % 2 == 0)
+			TEST_ASSERT(value == NULL);
+		else
+			TEST_ASSERT(value == (i == 7 ? &ints[N] : &ints[i]));
+	}
+
+	concurrent_map_destroy(map);
+	free(ints);
+}
+
+// Ταυτόχρονη χρήση: τα keys 0..STABLE-1 εισάγονται στην αρχή και δεν αλλάζουν ποτέ, οπότε οι readers πρέπει
+// να τα βρίσκουν πάντα (ακόμα και κατά τη διάρκεια rehash), ενώ κάθε writer εισάγει και διαγράφει συνεχώς
+// τα δικά του keys (τα οποία οι readers πρέπει να βρίσκουν είτε με τη σωστή τιμή είτε καθόλου).
+
+#define STABLE 10000
+#define WRITERS 4
+#define READERS 4
+#define WRITER_KEYS 20000
+
+// Κοινά δεδομένα όλων των threads
+struct shared {
+	ConcurrentMap map;
+	int* ints;
+	atomic_int errors;
+	atomic_bool done;
+};
+
+// Το όρισμα κάθε thread
+struct thread_arg {
+	struct shared* shared;
+	int id;
+};
+
+static void* writer_main(void* arg) {
+	struct shared* shared = ((struct thread_arg*)arg)->shared;
+	int first = STABLE + ((struct thread_arg*)arg)->id * WRITER_KEYS;
+
+	for (int round = 0; round < 5; round++) {
+		for (int i = first; i < first + WRITER_KEYS; i++)
+			concurrent_map_insert(shared->map, &shared->ints[i], &shared->ints[i]);
+		for (int i = first; i < first + WRITER_KEYS; i++)
+			if (!concurrent_map_remove(shared->map, &shared->ints[i]))
+				shared->errors++;
+	}
+
+	// Στο τέλος μένουν τα μισά keys του writer
+	for (int i = first; i < first + WRITER_KEYS; i += 2)
+		concurrent_map_insert(shared->map, &shared->ints[i], &shared->ints[i]);
+	return NULL;
+}
+
+static void* reader_main(void* arg) {
+	struct shared* shared = ((struct thread_arg*)arg)->shared;
+	uint end = STABLE + WRITERS * WRITER_KEYS;
+
+	// Ψευδοτυχαία keys (διαφορετική ακολουθία σε κάθε reader)
+	for (uint i = ((struct thread_arg*)arg)->id; !shared->done; i = (i * 1103515245u + 12345u) % end) {
+		Pointer value = concurrent_map_find(shared->map, &shared->ints[i]);
+		if (i < STABLE ? value != &shared->ints[i] : value != NULL && value != &shared->ints[i])
+			shared->errors++;
+	}
+	return NULL;
+}
+
+static int compare_pointers(Pointer a, Pointer b) {
+	return a == b ? 0 : a < b ? -1 : 1;
+}
+
+void test_small_keys(void) {
+	// Keys που δεν είναι διευθύνσεις: NULL και μικροί ακέραιοι μέσα στον Pointer
+	ConcurrentMap map = concurrent_map_create(compare_pointers, hash_pointer);
+	for (intptr_t i = 0; i < 100; i++)
+		concurrent_map_insert(map, (Pointer)i, (Pointer)(i + 1));
+	TEST_ASSERT(concurrent_map_size(map) == 100);
+	for (intptr_t i = 0; i < 100; i++)
+		TEST_ASSERT(concurrent_map_find(map, (Pointer)i) == (Pointer)(i + 1));
+
+	TEST_ASSERT(concurrent_map_remove(map, NULL));
+	TEST_ASSERT(concurrent_map_remove(map, (Pointer)1));
+	TEST_ASSERT(concurrent_map_find(map, NULL) == NULL);
+	TEST_ASSERT(concurrent_map_find(map, (Pointer)1) == NULL);
+	TEST_ASSERT(concurrent_map_find(map, (Pointer)2) == (Pointer)3);
+	TEST_ASSERT(concurrent_map_size(map) == 98);
+
+	concurrent_map_destroy(map);
+}
+
+void test_concurrent(void) {
+	int* ints = create_ints(STABLE + WRITERS * WRITER_KEYS);
+	struct shared shared = { .map = concurrent_map_create(compare_ints, hash_int), .ints = ints };
+	atomic_init(&shared.errors, 0);
+	atomic_init(&shared.done, false);
+
+	for (int i = 0; i < STABLE; i++)
+		concurrent_map_insert(shared.map, &ints[i], &ints[i]);
+
+	pthread_t threads[WRITERS + READERS];
+	struct thread_arg args[WRITERS + READERS];
+	for (int i = 0; i < WRITERS + READERS; i++) {
+		args[i].shared = &shared;
+		args[i].id = i < WRITERS ? i : i - WRITERS;
+		pthread_create(&threads[i], NULL, i < WRITERS ? writer_main : reader_main, &args[i]);
+	}
+
+	for (int i = 0; i < WRITERS; i++)
+		pthread_join(threads[i], NULL);
+	shared.done = true;
+	for (int i = WRITERS; i < WRITERS + READERS; i++)
+		pthread_join(threads[i], NULL);
+
+	TEST_ASSERT(shared.errors == 0);
+
+	// Τελική κατάσταση: όλα τα σταθερά keys και τα μισά keys κάθε writer
+	TEST_ASSERT(concurrent_map_size(shared.map) == STABLE + WRITERS * WRITER_KEYS / 2);
+	for (int i = 0; i < STABLE + WRITERS * WRITER_KEYS; i++) {
+		bool present = i < STABLE || (i - STABLE) % 2 == 0;
+		TEST_ASSERT(concurrent_map_find(shared.map, &ints[i]) == (present ? &ints[i] : NULL));
+	}
+
+	concurrent_map_destroy(shared.map);
+	free(ints);
+}
+
+void test_churn_memory(void) {
+	// Συνεχείς εισαγωγές νέων keys και διαγραφές παλιών, με σταθερό πλήθος στοιχείων: ο πίνακας κάθε stripe
+	// γεμίζει συνέχεια με DELETED κελιά και καθαρίζει με rehash ίδιου μεγέθους, που πρέπει να ξαναχρησιμοποιεί
+	// τους παλιούς πίνακες αντί να δεσμεύει συνέχεια νέους.
+	ConcurrentMap map = concurrent_map_create(compare_pointers, hash_pointer);
+	int live = 1000;
+	int warmup = 20 * live;
+
+	size_t warm_memory = 0;
+	for (intptr_t i = 0; i < 500 * live; i++) {
+		concurrent_map_insert(map, (Pointer)i, (Pointer)i);
+		if (i >= live)
+			TEST_ASSERT(concurrent_map_remove(map, (Pointer)(i - live)));
+		if (i == warmup)
+			warm_memory = concurrent_map_memory(map);
+	}
+	TEST_ASSERT(concurrent_map_size(map) == live);
+	// Τα stripes μπορεί ακόμα να μεγαλώσουν λίγο (το πλήθος στοιχείων κάθε stripe αυξομειώνεται), αλλά η
+	// μνήμη δεν πρέπει να αυξάνεται με το πλήθος των rehash
+	TEST_ASSERT(concurrent_map_memory(map) <= 2 * warm_memory);
+
+	concurrent_map_destroy(map);
+}
+
+
+// Λίστα με όλα τα tests προς εκτέλεση
+TEST_LIST = {
+	{ "concurrent_map_create", test_create },
+	{ "insert_find_remove", test_insert_find_remove },
+	{ "small_keys", test_small_keys },
+	{ "concurrent", test_concurrent },
+	{ "churn_memory", test_churn_memory },
+	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
+};
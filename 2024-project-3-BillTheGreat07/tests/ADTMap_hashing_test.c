@@ -0,0 +1,787 @@
+//////////////////////////////////////////////////////////////////
+//
+// Unit tests για τις επιπλέον λειτουργίες του ADT Map που αφορούν
+// υλοποιήσεις βασισμένες σε hashing (UsingHashTable).
+//
+//////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "acutest.h"			// Απλή βιβλιοθήκη για unit testing
+
+#include "ADTMap.h"
+
+
+int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Επιστρέφει έναν ακέραιο σε νέα μνήμη με τιμή value
+int* create_int(int value) {
+	int* p = malloc(sizeof(int));
+	*p = value;
+	return p;
+}
+
+void test_sizing_power_of_two(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+	map_set_sizing(map, MAP_SIZE_POWER_OF_TWO);
+
+	// Διαδοχικά keys, τα οποία με identity hash και mask θα έπεφταν όλα σε γειτονικές θέσεις
+	int N = 10000;
+	for (int i = 0; i < N; i++) {
+		map_insert(map, create_int(i), create_int(2*i));
+		TEST_ASSERT(map_size(map) == i + 1);
+	}
+
+	for (int i = 0; i < N; i++) {
+		int* value = map_find(map, &i);
+		TEST_ASSERT(value != NULL && *value == 2*i);
+	}
+
+	int not_exists = -1;
+	TEST_ASSERT(map_find(map, &not_exists) == NULL);
+
+	// Διάσχιση
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node))
+		count++;
+	TEST_ASSERT(count == N);
+
+	// Διαγραφή των μισών
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(map_remove(map, &i));
+	TEST_ASSERT(map_size(map) == N / 2);
+
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT((map_find(map, &i) == NULL) == (i % 2 == 0));
+
+	map_destroy(map);
+}
+
+void test_purge_deleted(void) {
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	// Εισάγουμε και διαγράφουμε συνεχώς νέα keys, με σταθερό πλήθος στοιχείων στο map.
+	// Ο πίνακας γεμίζει με DELETED, που πρέπει να καθαρίζονται χωρίς να μεγαλώνει ο πίνακας.
+	int N = 10, M = 100000;
+	int* keys = malloc(M * sizeof(*keys));
+	for (int i = 0; i < M; i++) {
+		keys[i] = i;
+		map_insert(map, &keys[i], &keys[i]);
+		if (i >= N)
+			TEST_ASSERT(map_remove(map, &keys[i - N]));
+
+		TEST_ASSERT(map_size(map) == (i < N ? i + 1 : N));
+	}
+
+	for (int i = 0; i < M; i++)
+		TEST_ASSERT((map_find(map, &keys[i]) != NULL) == (i >= M - N));
+
+	MapStats stats = map_stats(map);
+	TEST_ASSERT(stats.grows == 0);
+	TEST_ASSERT(stats.purges > 0);
+
+	map_destroy(map);
+	free(keys);
+}
+
+// Συνάρτηση κατακερματισμού που δίνει σε όλα τα keys το ίδιο hash code, ώστε να συγκρούονται πάντα
+static uint hash_constant(Pointer value) {
+	return 42;
+}
+
+void test_colliding_remove(void) {
+	// Όπως το map3 του ADTMap_test (που με τις hash_int μετά το seeding δεν εγγυάται πλέον σύγκρουση),
+	// αλλά με keys που σίγουρα κάνουν hash στην ίδια θέση: μετά τη διαγραφή του πρώτου key, το δεύτερο
+	// (που βρίσκεται μετά από αυτό στην αλυσίδα) πρέπει να βρίσκεται ακόμα.
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_constant);
+
+	int key1 = 1, key2 = 54, key3 = 107;
+	int value1 = 1, value2 = 2;
+	map_insert(map, &key1, &value1);
+	map_insert(map, &key2, &value1);
+	map_insert(map, &key3, &value1);
+
+	TEST_ASSERT(map_remove(map, &key1));
+	TEST_ASSERT(map_find(map, &key1) == NULL);
+	TEST_ASSERT(map_find(map, &key2) == &value1);
+	TEST_ASSERT(map_find(map, &key3) == &value1);
+
+	map_insert(map, &key2, &value2);			// πρέπει να αντικαταστήσει το key2, όχι να το εισάγει στο DELETED κελί
+	TEST_ASSERT(map_size(map) == 2);
+	TEST_ASSERT(map_find(map, &key2) == &value2);
+
+	TEST_ASSERT(map_remove(map, &key2));
+	TEST_ASSERT(map_find(map, &key2) == NULL);
+	TEST_ASSERT(!map_remove(map, &key2));
+	TEST_ASSERT(map_find(map, &key3) == &value1);
+	TEST_ASSERT(map_size(map) == 1);
+
+	map_destroy(map);
+}
+
+void test_shrink(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+
+	// Εισάγουμε πολλά στοιχεία και διαγράφουμε σχεδόν όλα, ο πίνακας πρέπει να μικρύνει αυτόματα
+	int N = 100000, K = 100;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	for (int i = K; i < N; i++)
+		TEST_ASSERT(map_remove(map, &i));
+
+	TEST_ASSERT(map_size(map) == K);
+	TEST_ASSERT(map_stats(map).shrinks > 0);
+
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		TEST_ASSERT(*(int*)map_node_key(map, node) < K);
+		count++;
+	}
+	TEST_ASSERT(count == K);
+
+	// Ρητό shrink μετά από μαζική εισαγωγή/διαγραφή
+	for (int i = K; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	for (int i = K; i < N; i += 2)
+		TEST_ASSERT(map_remove(map, &i));
+
+	int shrinks = map_stats(map).shrinks;
+	map_shrink_to_fit(map);
+	TEST_ASSERT(map_stats(map).shrinks == shrinks + 1);
+
+	TEST_ASSERT(map_size(map) == K + (N - K) / 2);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT((map_find(map, &i) != NULL) == (i < K || i % 2 == 1));
+
+	map_destroy(map);
+}
+
+void test_rehash_step(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+
+	// Χωρίς μεταφορά στις λειτουργίες, το rehash προχωράει μόνο με τη map_rehash_step
+	map_set_rehash_budget(map, 0);
+
+	int N = 1000;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+
+	// Το τελευταίο rehash είναι σε εξέλιξη, οπότε κάποιες αναζητήσεις βρίσκουν το key στον παλιό πίνακα
+	TEST_ASSERT(!map_rehash_step(map, 0));
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(*(int*)map_find(map, &i) == i);
+
+	MapStats stats = map_stats(map);
+	TEST_ASSERT(stats.old_lookups > 0);
+	TEST_ASSERT(stats.old_hits > 0 && stats.old_hits <= stats.old_lookups);
+
+	// Ολοκλήρωση του rehash σε μικρά βήματα, μετά από αυτό δε χρειάζεται πλέον ο παλιός πίνακας
+	while (!map_rehash_step(map, 10))
+		;
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(*(int*)map_find(map, &i) == i);
+	TEST_ASSERT(map_stats(map).old_lookups == stats.old_lookups);
+
+	// Με budget 0 οι αναζητήσεις δεν τροποποιούν το map (ούτε τα στατιστικά), οπότε γίνονται και κατά τη διάσχιση
+	map_set_rehash_budget(map, 4);
+	for (int i = N; i < 2 * N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	TEST_ASSERT(!map_rehash_step(map, 0));
+
+	map_set_find_rehash_budget(map, 0);
+	stats = map_stats(map);
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		TEST_ASSERT(map_find(map, map_node_key(map, node)) == map_node_value(map, node));
+		count++;
+	}
+	TEST_ASSERT(count == 2 * N);
+	TEST_ASSERT(!map_rehash_step(map, 0));
+	TEST_ASSERT(map_stats(map).old_lookups == stats.old_lookups);
+
+	// Με budget για τις αναζητήσεις, αυτές αρκούν για να ολοκληρωθεί το rehash
+	map_set_find_rehash_budget(map, 4);
+	for (int i = 0; i < 2 * N; i++)
+		TEST_ASSERT(*(int*)map_find(map, &i) == i);
+	TEST_ASSERT(map_rehash_step(map, 0));
+
+	map_destroy(map);
+
+	// Το ίδιο ισχύει και εξ ορισμού: ένα map που μετά από rehash δέχεται μόνο αναζητήσεις ολοκληρώνει τη μεταφορά
+	map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+	map_set_rehash_budget(map, 0);
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	TEST_ASSERT(!map_rehash_step(map, 0));
+
+	for (int round = 0; round < 4; round++)
+		for (int i = 0; i < N; i++)
+			TEST_ASSERT(*(int*)map_find(map, &i) == i);
+	TEST_ASSERT(map_rehash_step(map, 0));
+
+	map_destroy(map);
+}
+
+void test_background_rehash(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+	map_set_background_rehash(map, true);
+
+	// Εισαγωγές με πολλά grow, και διαγραφές με purge/shrink, στα οποία ο έτοιμος πίνακας δεν ταιριάζει
+	int N = 100000;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	TEST_ASSERT(map_size(map) == N);
+	TEST_ASSERT(map_stats(map).grows > 0);
+
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(*(int*)map_find(map, &i) == i);
+
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(map_remove(map, &i));
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT((map_find(map, &i) != NULL) == (i % 2 == 1));
+
+	map_destroy(map);
+}
+
+void test_reserve(void) {
+	// Με δέσμευση χώρου εκ των προτέρων, η εισαγωγή N στοιχείων δεν κάνει κανένα rehash
+	int N = 10000;
+	Map map = map_create_with_capacity(compare_ints, free, free, N);
+	map_set_hash_function(map, hash_int);
+
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+
+	TEST_ASSERT(map_size(map) == N);
+	TEST_ASSERT(map_stats(map).grows == 0);
+
+	// map_reserve σε map που έχει ήδη στοιχεία
+	map_reserve(map, 4 * N);
+	int grows = map_stats(map).grows;
+	for (int i = N; i < 4 * N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	TEST_ASSERT(map_stats(map).grows == grows);
+
+	for (int i = 0; i < 4 * N; i++)
+		TEST_ASSERT(*(int*)map_find(map, &i) == i);
+
+	map_destroy(map);
+
+	// Η δέσμευση διατηρείται και με αλλαγή του τρόπου επιλογής μεγέθους
+	map = map_create_with_capacity(compare_ints, free, free, N);
+	map_set_hash_function(map, hash_int);
+	map_set_sizing(map, MAP_SIZE_POWER_OF_TWO);
+
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), create_int(i));
+	TEST_ASSERT(map_stats(map).grows == 0);
+
+	map_destroy(map);
+}
+
+void test_find_insert_many(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+
+	// Εισαγωγή ενός batch που δεν είναι πολλαπλάσιο του εσωτερικού μεγέθους ομάδας, και περιέχει διπλότυπα
+	int N = 1003;
+	Pointer* keys = malloc(2 * N * sizeof(*keys));
+	Pointer* values = malloc(2 * N * sizeof(*values));
+	for (int i = 0; i < N; i++) {
+		keys[i] = create_int(i);
+		values[i] = create_int(2 * i);
+	}
+	free(keys[N - 1]);
+	keys[N - 1] = create_int(0);			// διπλότυπο του keys[0], πρέπει να αντικαταστήσει το πρώτο ζευγάρι
+	free(values[N - 1]);
+	values[N - 1] = create_int(-1);
+
+	map_insert_many(map, keys, values, N);
+	TEST_ASSERT(map_size(map) == N - 1);
+
+	// Αναζήτηση keys που υπάρχουν και keys που δεν υπάρχουν
+	for (int i = 0; i < 2 * N; i++)
+		keys[i] = create_int(i);
+	map_find_many(map, keys, 2 * N, values);
+
+	TEST_ASSERT(*(int*)values[0] == -1);
+	for (int i = 1; i < 2 * N; i++) {
+		if (i < N - 1)
+			TEST_ASSERT(values[i] != NULL && *(int*)values[i] == 2 * i);
+		else
+			TEST_ASSERT(values[i] == NULL);
+	}
+
+	for (int i = 0; i < 2 * N; i++)
+		free(keys[i]);
+	map_destroy(map);
+
+	// Με πολύ μεγάλο budget για τις αναζητήσεις, η map_find_many ολοκληρώνει το rehash (χωρίς overflow στο n * budget)
+	map = map_create(compare_ints, free, NULL);
+	map_set_hash_function(map, hash_int);
+	map_set_rehash_budget(map, 0);
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), NULL);
+	TEST_ASSERT(!map_rehash_step(map, 0));
+
+	map_set_find_rehash_budget(map, INT_MAX / 2);
+	int key = 0;
+	keys[0] = keys[1] = keys[2] = &key;
+	map_find_many(map, keys, 3, values);
+	TEST_ASSERT(map_rehash_step(map, 0));
+
+	free(keys);
+	free(values);
+	map_destroy(map);
+}
+
+// Συνάρτηση κατακερματισμού που δίνει το ίδιο hash code σε ομάδες 16 διαδοχικών ακεραίων, ώστε να
+// σχηματίζονται αλυσίδες που ξεπερνούν τα όρια των περιοχών της map_build_parallel
+static uint hash_clustered(Pointer value) {
+	return (*(int*)value / 16) * 7919u;
+}
+
+void test_build_parallel(void) {
+	int N = 100000;
+	Pointer* keys = malloc(N * sizeof(*keys));
+	Pointer* values = malloc(N * sizeof(*values));
+
+	HashFunc hash_functions[] = { hash_int, hash_clustered };
+	for (int sizing = MAP_SIZE_PRIME; sizing <= MAP_SIZE_POWER_OF_TWO; sizing++) {
+		for (int h = 0; h < 2; h++) {
+			Map map = map_create(compare_ints, free, free);
+			map_set_sizing(map, sizing);
+			map_set_hash_function(map, hash_functions[h]);
+
+			// Τα keys περιέχουν διπλότυπα (κάθε 1000ό key είναι ίσο με το προηγούμενο), τα οποία πρέπει να
+			// αντικαταστήσουν το προηγούμενο ζευγάρι, όπως στην map_insert_many
+			for (int i = 0; i < N; i++) {
+				keys[i] = create_int(i % 1000 == 999 ? i - 1 : i);
+				values[i] = create_int(i);
+			}
+
+			map_build_parallel(map, keys, values, N, 4);
+			TEST_ASSERT(map_size(map) == N - N / 1000);
+			TEST_ASSERT(map_stats(map).grows == 0);
+
+			for (int i = 0; i < N; i++) {
+				int* value = map_find(map, &i);
+				if (i % 1000 == 999)
+					TEST_ASSERT(value == NULL);
+				else
+					TEST_ASSERT(value != NULL && *value == (i % 1000 == 998 ? i + 1 : i));
+			}
+
+			// Μετά το χτίσιμο το map λειτουργεί κανονικά
+			int key = N;
+			map_insert(map, create_int(N), create_int(N));
+			TEST_ASSERT(*(int*)map_find(map, &key) == N);
+			key = 0;
+			TEST_ASSERT(map_remove(map, &key));
+			TEST_ASSERT(map_size(map) == N - N / 1000);
+
+			// Το χτίσιμο δεν κάνει map_reserve, οπότε μετά από διαγραφές ο πίνακας μικραίνει κανονικά
+			for (int i = 1; i < N; i++)
+				map_remove(map, &i);
+			TEST_ASSERT(map_size(map) == 1);
+			TEST_ASSERT(map_stats(map).shrinks > 0);
+
+			map_destroy(map);
+		}
+	}
+
+	// Σε map που δεν είναι κενό, ή με λίγα στοιχεία, η εισαγωγή γίνεται σειριακά (ίδιο αποτέλεσμα)
+	Map map = map_create(compare_ints, free, NULL);
+	map_set_hash_function(map, hash_int);
+	map_insert(map, create_int(-1), NULL);
+	for (int i = 0; i < 100; i++)
+		keys[i] = create_int(i);
+	map_build_parallel(map, keys, values, 100, 8);
+	TEST_ASSERT(map_size(map) == 101);
+	for (int i = -1; i < 100; i++)
+		TEST_ASSERT(map_find_node(map, &i) != MAP_EOF);
+	map_destroy(map);
+
+	free(keys);
+	free(values);
+}
+
+static Pointer increment(Pointer value) {
+	if (value == NULL)
+		return create_int(1);
+
+	(*(int*)value)++;
+	return value;
+}
+
+void test_find_or_insert(void) {
+	Map map = map_create(compare_ints, free, free);
+	map_set_hash_function(map, hash_int);
+
+	// Αρκετές εισαγωγές ώστε να γίνουν rehash, ο κόμβος που επιστρέφεται πρέπει να μένει έγκυρος
+	int N = 1000;
+	for (int i = 0; i < N; i++) {
+		bool inserted;
+		MapNode node = map_find_or_insert(map, create_int(i), &inserted);
+		TEST_ASSERT(inserted);
+		TEST_ASSERT(map_node_value(map, node) == NULL);
+		map_node_set_value(map, node, create_int(i));
+	}
+	TEST_ASSERT(map_size(map) == N);
+
+	for (int i = 0; i < N; i++) {
+		int key = i;
+		bool inserted;
+		MapNode node = map_find_or_insert(map, &key, &inserted);
+		TEST_ASSERT(!inserted);
+		TEST_ASSERT(*(int*)map_node_key(map, node) == i);			// το map κρατάει το δικό του key
+		TEST_ASSERT(*(int*)map_node_value(map, node) == i);
+		map_node_set_value(map, node, create_int(-i));			// η παλιά τιμή γίνεται free
+	}
+
+	// map_update: μέτρηση εμφανίσεων
+	Map counts = map_create(compare_ints, free, free);
+	map_set_hash_function(counts, hash_int);
+	for (int i = 0; i < N; i++) {
+		int* key = create_int(i % 10);
+		bool existed = map_find(counts, key) != NULL;
+		map_update(counts, key, increment);
+		if (existed)
+			free(key);												// το key δεν κρατήθηκε από το map
+	}
+	TEST_ASSERT(map_size(counts) == 10);
+	for (int i = 0; i < 10; i++)
+		TEST_ASSERT(*(int*)map_find(counts, &i) == N / 10);
+
+	map_destroy(counts);
+	map_destroy(map);
+}
+
+void test_hashed(void) {
+	// Δύο maps με την ίδια συνάρτηση κατακερματισμού, το hash κάθε key υπολογίζεται μία φορά
+	Map maps[2];
+	for (int m = 0; m < 2; m++) {
+		maps[m] = map_create(compare_ints, NULL, NULL);
+		map_set_hash_function(maps[m], hash_int);
+	}
+
+	int N = 1000;
+	int* keys = malloc(N * sizeof(*keys));
+	uint* hashes = malloc(N * sizeof(*hashes));
+	for (int i = 0; i < N; i++) {
+		keys[i] = i;
+		hashes[i] = map_hash(maps[0], &keys[i]);
+		TEST_ASSERT(hashes[i] == map_hash(maps[1], &keys[i]));		// ίδια συνάρτηση και (default) seed
+
+		for (int m = 0; m < 2; m++)
+			map_insert_hashed(maps[m], &keys[i], &keys[i], hashes[i]);
+	}
+
+	for (int i = 0; i < N; i++) {
+		for (int m = 0; m < 2; m++)
+			TEST_ASSERT(map_find_hashed(maps[m], &keys[i], hashes[i]) == &keys[i]);
+
+		// Οι λειτουργίες με και χωρίς hash είναι ισοδύναμες
+		TEST_ASSERT(map_find(maps[0], &keys[i]) == &keys[i]);
+	}
+
+	// Διαγραφή των μισών keys από το πρώτο map
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(map_remove_hashed(maps[0], &keys[i], hashes[i]));
+	TEST_ASSERT(!map_remove_hashed(maps[0], &keys[0], hashes[0]));
+	TEST_ASSERT(map_size(maps[0]) == N / 2);
+
+	for (int i = 0; i < N; i++) {
+		TEST_ASSERT(map_find_hashed(maps[0], &keys[i], hashes[i]) == (i % 2 == 0 ? NULL : &keys[i]));
+		TEST_ASSERT(map_find_hashed(maps[1], &keys[i], hashes[i]) == &keys[i]);
+	}
+
+	for (int m = 0; m < 2; m++)
+		map_destroy(maps[m]);
+	free(keys);
+	free(hashes);
+}
+
+void test_hash_seed(void) {
+	Map map = map_create(compare_ints, free, NULL);
+	map_set_hash_function(map, hash_int);
+
+	int N = 1000;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), NULL);
+
+	// Η αλλαγή του seed αλλάζει τα hash codes, αλλά τα στοιχεία βρίσκονται κανονικά
+	int key = 1;
+	map_set_hash_seed(map, 1);
+	uint hash1 = map_hash(map, &key);
+	map_set_hash_seed(map, 2);
+	uint hash2 = map_hash(map, &key);
+	TEST_ASSERT(hash1 != hash2);
+
+	TEST_ASSERT(map_size(map) == N);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(map_find_node(map, &i) != MAP_EOF);
+
+	// Με το ίδιο seed, το ίδιο hash code
+	map_set_hash_seed(map, 1);
+	TEST_ASSERT(map_hash(map, &key) == hash1);
+
+	// Οι συναρτήσεις της βιβλιοθήκης ανακατεύουν όλα τα bits: διαδοχικά ints, strings που διαφέρουν σε ένα
+	// χαρακτήρα και pointers με alignment δίνουν hash codes που διαφέρουν και στα κάτω και στα πάνω bits.
+	int ints[2] = { 0, 1 };
+	char* strings[2] = { "key_0000000000000000000", "key_0000000000000000001" };
+	Pointer pointers[2] = { &ints[0], &ints[1] };
+	uint pairs[3][2] = {
+		{ hash_int(&ints[0]), hash_int(&ints[1]) },
+		{ hash_string(strings[0]), hash_string(strings[1]) },
+		{ hash_pointer(pointers[0]), hash_pointer(pointers[1]) },
+	};
+	for (int i = 0; i < 3; i++) {
+		TEST_ASSERT((pairs[i][0] & 0xFFFF) != (pairs[i][1] & 0xFFFF));
+		TEST_ASSERT((pairs[i][0] >> 16) != (pairs[i][1] >> 16));
+	}
+
+	map_destroy(map);
+}
+
+// Συνάρτηση κατακερματισμού του χρήστη, που δεν ανακατεύει καθόλου τα bits (άρα οι θέσεις των keys είναι προβλέψιμες)
+static uint hash_identity(Pointer value) {
+	return *(int*)value;
+}
+
+void test_hash_flooding(void) {
+	Map map = map_create(compare_ints, free, NULL);
+	map_set_sizing(map, MAP_SIZE_POWER_OF_TWO);
+	map_set_hash_function(map, hash_identity);
+
+	// Στις δυνάμεις του 2 η θέση είναι τα υψηλά bits του hash * FIBONACCI_MULTIPLIER. Ένας επιτιθέμενος που
+	// το γνωρίζει επιλέγει keys i * inverse (όπου inverse ο αντίστροφος του 2654435769 mod 2^32), ώστε το
+	// γινόμενο να είναι απλά i: όλα τα keys πέφτουν στη θέση 0, για οποιοδήποτε μέγεθος πίνακα.
+	uint inverse = 2654435769u;
+	for (int i = 0; i < 5; i++)
+		inverse *= 2 - 2654435769u * inverse;			// μέθοδος Newton, κάθε βήμα διπλασιάζει τα σωστά bits
+	TEST_ASSERT(inverse * 2654435769u == 1);
+
+	int N = 20000;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i * inverse), NULL);
+
+	// Χωρίς αντιμετώπιση, κάθε εισαγωγή θα εξέταζε όλα τα προηγούμενα keys (N^2 / 2 κελιά συνολικά).
+	// Το map πρέπει να εντόπισε το flooding, και οι αλυσίδες να έμειναν μικρές.
+	MapStats stats = map_stats(map);
+	TEST_ASSERT(stats.floods >= 1);
+	TEST_ASSERT(stats.longest_probe < 128);
+
+	TEST_ASSERT(map_size(map) == N);
+	for (int i = 0; i < N; i++) {
+		int key = i * inverse;
+		TEST_ASSERT(map_find_node(map, &key) != MAP_EOF);
+	}
+
+	// Τα hash codes δεν άλλαξαν, οι τιμές της map_hash ισχύουν ακόμα
+	int key = 5 * inverse;
+	TEST_ASSERT(map_hash(map, &key) == hash_identity(&key));
+
+	map_destroy(map);
+
+	// Keys με ακριβώς το ίδιο hash code δεν διαχωρίζονται από το salt: το map παραμένει σωστό, αλλά δεν
+	// ξαναχτίζει τον πίνακα σε κάθε εισαγωγή, μόνο μία φορά για κάθε μέγεθος πίνακα.
+	map = map_create(compare_ints, free, NULL);
+	map_set_hash_function(map, hash_constant);
+
+	N = 2000;
+	for (int i = 0; i < N; i++)
+		map_insert(map, create_int(i), NULL);
+
+	stats = map_stats(map);
+	TEST_ASSERT(stats.floods >= 1);
+	TEST_ASSERT(stats.floods <= stats.grows + 1);
+	TEST_ASSERT(stats.longest_probe >= N / 2);			// η αλυσίδα δεν μίκρυνε
+
+	TEST_ASSERT(map_size(map) == N);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(map_find_node(map, &i) != MAP_EOF);
+
+	map_destroy(map);
+}
+
+// Key 12 bytes (δεν είναι πολλαπλάσιο του 8) για τα inline maps
+typedef struct {
+	int x, y, z;
+} Point;
+
+static int compare_points(Pointer a, Pointer b) {
+	return memcmp(a, b, sizeof(Point));
+}
+
+static uint hash_point(Pointer value) {
+	Point* point = value;
+	return hash_int(&point->x) ^ (hash_int(&point->y) * 31) ^ (hash_int(&point->z) * 961);
+}
+
+static Pointer double_value(Pointer value) {
+	*(long*)value *= 2;
+	return value;
+}
+
+void test_inline(void) {
+	Map map = map_create_inline(sizeof(Point), sizeof(long), compare_points);
+	map_set_hash_function(map, hash_point);
+	map_set_background_rehash(map, true);
+
+	// Τα keys/values είναι τοπικές μεταβλητές, το map κρατάει αντίγραφα
+	int N = 10000;
+	for (int i = 0; i < N; i++) {
+		Point point = { i, -i, i * 7 };
+		long value = i;
+		map_insert(map, &point, &value);
+		TEST_ASSERT(map_size(map) == i + 1);
+	}
+
+	for (int i = 0; i < N; i++) {
+		Point point = { i, -i, i * 7 };
+		long* value = map_find(map, &point);
+		TEST_ASSERT(value != NULL && *value == i);
+	}
+	Point missing = { 1, 1, 1 };
+	TEST_ASSERT(map_find(map, &missing) == NULL);
+
+	// Αντικατάσταση, map_update (η συνάρτηση αλλάζει το value μέσα στον κόμβο) και map_find_or_insert
+	Point point = { 5, -5, 35 };
+	long value = 500;
+	map_insert(map, &point, &value);
+	map_update(map, &point, double_value);
+	TEST_ASSERT(*(long*)map_find(map, &point) == 1000);
+	TEST_ASSERT(map_size(map) == N);
+
+	bool inserted;
+	MapNode node = map_find_or_insert(map, &missing, &inserted);
+	TEST_ASSERT(inserted && *(long*)map_node_value(map, node) == 0);
+	TEST_ASSERT(compare_points(map_node_key(map, node), &missing) == 0);
+	TEST_ASSERT(map_node_key(map, node) != &missing);
+
+	// Διαγραφή των μισών, και διάσχιση
+	for (int i = 0; i < N; i += 2) {
+		Point point = { i, -i, i * 7 };
+		TEST_ASSERT(map_remove(map, &point));
+	}
+	TEST_ASSERT(map_remove(map, &missing));
+	TEST_ASSERT(map_size(map) == N / 2);
+
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		Point* key = map_node_key(map, node);
+		long* value = map_node_value(map, node);
+		TEST_ASSERT(key->x % 2 == 1 && key->y == -key->x && key->z == key->x * 7);
+		TEST_ASSERT(*value == (key->x == 5 ? 1000 : key->x));
+		count++;
+	}
+	TEST_ASSERT(count == N / 2);
+
+	map_destroy(map);
+}
+
+void test_inline_set(void) {
+	// Με value_size 0 το map είναι σύνολο
+	Map set = map_create_inline(sizeof(int), 0, compare_ints);
+	map_set_hash_function(set, hash_int);
+
+	for (int i = 0; i < 1000; i += 3)
+		map_insert(set, &i, NULL);
+	for (int i = 0; i < 1000; i++)
+		TEST_ASSERT((map_find(set, &i) != NULL) == (i % 3 == 0));
+
+	map_destroy(set);
+}
+
+static int compare_strings(Pointer a, Pointer b) {
+	return strcmp(a, b);
+}
+
+void test_insert_copy_string(void) {
+	Map map = map_create(compare_strings, NULL, free);
+	map_set_hash_function(map, hash_string);
+
+	// Ολα τα keys γράφονται στο ίδιο buffer, οπότε το map πρέπει να κρατάει δικά του αντίγραφα
+	// (αρκετά ώστε να γίνουν πολλά rehash, άρα και πολλές αντιγραφές σε νέο arena)
+	char buffer[32];
+	int N = 20000;
+	for (int i = 0; i < N; i++) {
+		sprintf(buffer, "key_%d", i);
+		map_insert_copy_string(map, buffer, create_int(i));
+	}
+	TEST_ASSERT(map_size(map) == N);
+
+	// Αντικατάσταση του value, το key δεν αντιγράφεται ξανά
+	sprintf(buffer, "key_%d", 7);
+	MapNode node = map_find_node(map, buffer);
+	Pointer key = map_node_key(map, node);
+	TEST_ASSERT(key != buffer && strcmp(key, "key_7") == 0);
+	map_insert_copy_string(map, buffer, create_int(-7));
+	TEST_ASSERT(map_size(map) == N);
+	TEST_ASSERT(map_node_key(map, map_find_node(map, buffer)) == key);
+
+	// Διαγραφή των περισσότερων keys, και shrink (που ανακτά τα αντίγραφά τους)
+	for (int i = 0; i < N; i++) {
+		if (i % 10 != 7) {
+			sprintf(buffer, "key_%d", i);
+			TEST_ASSERT(map_remove(map, buffer));
+		}
+	}
+	map_shrink_to_fit(map);
+	TEST_ASSERT(map_size(map) == N / 10);
+
+	for (int i = 0; i < N; i++) {
+		sprintf(buffer, "key_%d", i);
+		int* value = map_find(map, buffer);
+		if (i % 10 == 7)
+			TEST_ASSERT(value != NULL && *value == (i == 7 ? -7 : i));
+		else
+			TEST_ASSERT(value == NULL);
+	}
+
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		int* value = map_node_value(map, node);
+		sprintf(buffer, "key_%d", *value == -7 ? 7 : *value);
+		TEST_ASSERT(strcmp(map_node_key(map, node), buffer) == 0);
+		count++;
+	}
+	TEST_ASSERT(count == N / 10);
+
+	map_destroy(map);
+}
+
+// Λίστα με όλα τα tests προς εκτέλεση
+TEST_LIST = {
+	{ "test_sizing_power_of_two",	test_sizing_power_of_two },
+	{ "test_purge_deleted",			test_purge_deleted },
+	{ "test_colliding_remove",		test_colliding_remove },
+	{ "test_shrink",				test_shrink },
+	{ "test_rehash_step",			test_rehash_step },
+	{ "test_background_rehash",		test_background_rehash },
+	{ "test_reserve",				test_reserve },
+	{ "test_find_insert_many",		test_find_insert_many },
+	{ "test_build_parallel",		test_build_parallel },
+	{ "test_find_or_insert",		test_find_or_insert },
+	{ "test_hashed",				test_hashed },
+	{ "test_hash_seed",				test_hash_seed },
+	{ "test_hash_flooding",			test_hash_flooding },
+	{ "test_inline",				test_inline },
+	{ "test_inline_set",			test_inline_set },
+	{ "test_insert_copy_string",	test_insert_copy_string },
+
+	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
+};
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////
+//
+// Unit tests για υλοποιήσεις του ADT Map στις οποίες η διάσχιση
+// γίνεται με τη σειρά εισαγωγής (UsingCompactHashTable).
+//
+//////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include "acutest.h"			// Απλή βιβλιοθήκη για unit testing
+
+#include "ADTMap.h"
+
+
+int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Ελέγχει ότι η διάσχιση του map επιστρέφει ακριβώς τα keys του πίνακα expected, με τη σειρά αυτή
+void check_order(Map map, int* expected, int n) {
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node)) {
+		TEST_ASSERT(count < n);
+		TEST_ASSERT(*(int*)map_node_key(map, node) == expected[count]);
+		count++;
+	}
+	TEST_ASSERT(count == n);
+}
+
+void test_insertion_order(void) {
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_int);
+
+	// Keys σε "τυχαία" σειρά, αρκετά ώστε να γίνουν πολλά rehash (και να αλλάξει το πλάτος των indices)
+	int N = 100000;
+	int* keys = malloc(N * sizeof(*keys));
+	for (int i = 0; i < N; i++) {
+		keys[i] = (int)((unsigned)i * 2654435761u);
+		map_insert(map, &keys[i], &keys[i]);
+	}
+	check_order(map, keys, N);
+
+	// Η αντικατάσταση ενός key δεν αλλάζει τη θέση του
+	map_insert(map, &keys[0], &keys[1]);
+	check_order(map, keys, N);
+
+	// Διαγραφή των περισσότερων keys (ώστε να γίνει συμπίεση), τα υπόλοιπα κρατάνε τη σειρά τους
+	int* expected = malloc(N * sizeof(*expected));
+	int remaining = 0;
+	for (int i = 0; i < N; i++) {
+		if (i % 10 != 0)
+			TEST_ASSERT(map_remove(map, &keys[i]));
+		else
+			expected[remaining++] = keys[i];
+	}
+	TEST_ASSERT(map_size(map) == remaining);
+	check_order(map, expected, remaining);
+
+	// Ένα key που διαγράφεται και ξαναμπαίνει πάει στο τέλος
+	TEST_ASSERT(map_remove(map, &keys[0]));
+	map_insert(map, &keys[0], &keys[0]);
+	for (int i = 0; i < remaining - 1; i++)
+		expected[i] = expected[i + 1];
+	expected[remaining - 1] = keys[0];
+	check_order(map, expected, remaining);
+
+	map_destroy(map);
+	free(keys);
+	free(expected);
+}
+
+// Λίστα με όλα τα tests προς εκτέλεση
+TEST_LIST = {
+	{ "test_insertion_order",	test_insertion_order },
+
+	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
+};
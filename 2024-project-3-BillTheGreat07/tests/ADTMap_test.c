@@ -417,6 +417,43 @@ void test_combined2(void) {
 	free(inserted);
 }
 
+// Hash function που επιστρέφει πάντα το ίδιο hash code, ώστε όλα τα keys να συγκρούονται
+uint hash_constant(Pointer value) {
+	return 42;
+}
+
+void test_equal_hashes(void) {
+	// Πολλά περισσότερα keys με το ίδιο hash code απ' όσα χωράνε σε ένα bucket ή μια γειτονιά
+	Map map = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(map, hash_constant);
+
+	int N = 200;
+	int* key_array = malloc(N * sizeof(*key_array));
+	for (int i = 0; i < N; i++) {
+		key_array[i] = i;
+		map_insert(map, &key_array[i], &key_array[i]);
+		TEST_ASSERT(map_size(map) == i + 1);
+	}
+
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(map_find(map, &key_array[i]) == &key_array[i]);
+
+	int count = 0;
+	for (MapNode node = map_first(map); node != MAP_EOF; node = map_next(map, node))
+		count++;
+	TEST_ASSERT(count == N);
+
+	// Διαγραφή των μισών, και έλεγχος ότι τα υπόλοιπα βρίσκονται ακόμα
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(map_remove(map, &key_array[i]));
+	TEST_ASSERT(map_size(map) == N / 2);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(map_find(map, &key_array[i]) == (i % 2 == 0 ? NULL : &key_array[i]));
+
+	map_destroy(map);
+	free(key_array);
+}
+
 // Λίστα με όλα τα tests προς εκτέλεση
 TEST_LIST = {
 	{ "test_create",		test_create },
@@ -428,6 +465,7 @@ TEST_LIST = {
 	{ "test_iterate",		test_iterate },
 	{ "test_combined",		test_combined },
 	{ "test_combined2",		test_combined2 },
+	{ "test_equal_hashes",	test_equal_hashes },
 
 	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
 }; 
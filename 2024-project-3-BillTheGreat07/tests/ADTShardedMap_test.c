@@ -0,0 +1,249 @@
+//////////////////////////////////////////////////////////////////
+//
+// Unit tests για τον ADT ShardedMap.
+// Οποιαδήποτε υλοποίηση οφείλει να περνάει όλα τα tests.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "acutest.h"			// Απλή βιβλιοθήκη για unit testing
+
+#include "ADTShardedMap.h"
+
+
+static int compare_ints(Pointer a, Pointer b) {
+	return *(int*)a - *(int*)b;
+}
+
+// Πίνακας με τους αριθμούς 0..n-1, που χρησιμοποιούνται ως keys
+static int* create_ints(int n) {
+	int* array = malloc(n * sizeof(*array));
+	for (int i = 0; i < n; i++)
+		array[i] = i;
+	return array;
+}
+
+// Μετρητές αποθηκευμένοι απευθείας μέσα στον Pointer του value
+
+static Pointer increment(Pointer value) {
+	return (Pointer)((intptr_t)value + 1);
+}
+
+static Pointer add(Pointer target_value, Pointer source_value) {
+	return (Pointer)((intptr_t)target_value + (intptr_t)source_value);
+}
+
+
+void test_create(void) {
+	ShardedMap map = sharded_map_create(10, false, compare_ints, hash_int, NULL, NULL);
+	TEST_ASSERT(map != NULL);
+	TEST_ASSERT(sharded_map_size(map) == 0);
+
+	int key = 0;
+	TEST_ASSERT(sharded_map_find(map, &key) == NULL);
+	TEST_ASSERT(!sharded_map_remove(map, &key));
+
+	sharded_map_destroy(map);
+}
+
+void test_insert_find_remove(void) {
+	ShardedMap map = sharded_map_create(16, false, compare_ints, hash_int, NULL, NULL);
+
+	int N = 10000;
+	int* ints = create_ints(N);
+	for (int i = 0; i < N; i++) {
+		sharded_map_insert(map, &ints[i], &ints[i]);
+		TEST_ASSERT(sharded_map_size(map) == i + 1);
+		TEST_ASSERT(sharded_map_find(map, &ints[i]) == &ints[i]);
+	}
+
+	// Τα keys συγκρίνονται με την compare, όχι με τη διεύθυνσή τους
+	int key = 7;
+	TEST_ASSERT(sharded_map_find(map, &key) == &ints[7]);
+
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(sharded_map_remove(map, &ints[i]));
+	TEST_ASSERT(sharded_map_size(map) == N / 2);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(sharded_map_find(map, &ints[i]) == (i % 2 == 0 ? NULL : &ints[i]));
+
+	sharded_map_destroy(map);
+	free(ints);
+}
+
+void test_merge(void) {
+	// Δύο maps με μετρητές, με κοινά τα keys 500..999
+	int* ints = create_ints(1500);
+	ShardedMap target = sharded_map_create(8, false, compare_ints, hash_int, NULL, NULL);
+	ShardedMap source = sharded_map_create(8, false, compare_ints, hash_int, NULL, NULL);
+	for (int i = 0; i < 1000; i++) {
+		sharded_map_update(target, &ints[i], increment);
+		sharded_map_update(source, &ints[500 + i], increment);
+		sharded_map_update(source, &ints[500 + i], increment);
+	}
+
+	sharded_map_merge(target, source, add);
+	TEST_ASSERT(sharded_map_size(source) == 0);
+	TEST_ASSERT(sharded_map_size(target) == 1500);
+	for (int i = 0; i < 1500; i++)
+		TEST_ASSERT((intptr_t)sharded_map_find(target, &ints[i]) == (i < 500 ? 1 : i < 1000 ? 3 : 2));
+
+	// Τελική συγχώνευση σε απλό Map, που έχει ήδη κάποια keys
+	Map result = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(result, hash_int);
+	map_insert(result, &ints[0], (Pointer)10);
+
+	sharded_map_merge_into(target, result, add);
+	TEST_ASSERT(sharded_map_size(target) == 0);
+	TEST_ASSERT(map_size(result) == 1500);
+	for (int i = 0; i < 1500; i++)
+		TEST_ASSERT((intptr_t)map_find(result, &ints[i]) == (i == 0 ? 11 : i < 500 ? 1 : i < 1000 ? 3 : 2));
+
+	// Σε κενό Map ο πίνακας μεγαλώνει εκ των προτέρων, αλλά μπορεί να μικρύνει μετά από διαγραφές
+	for (int i = 0; i < 1500; i++)
+		sharded_map_insert(source, &ints[i], (Pointer)1);
+	Map empty = map_create(compare_ints, NULL, NULL);
+	map_set_hash_function(empty, hash_int);
+	sharded_map_merge_into(source, empty, add);
+	TEST_ASSERT(map_size(empty) == 1500 && map_stats(empty).grows == 0);
+	for (int i = 0; i < 1500; i++)
+		TEST_ASSERT(map_remove(empty, &ints[i]));
+	TEST_ASSERT(map_stats(empty).shrinks > 0);
+	map_destroy(empty);
+
+	// Το source παραμένει χρησιμοποιήσιμο μετά τη συγχώνευση
+	sharded_map_insert(source, &ints[1], (Pointer)1);
+	TEST_ASSERT(sharded_map_find(source, &ints[1]) == (Pointer)1);
+
+	map_destroy(result);
+	sharded_map_destroy(target);
+	sharded_map_destroy(source);
+	free(ints);
+}
+
+void test_merge_destroy(void) {
+	// Με destroy_key/destroy_value: τα keys/values που μεταφέρονται ανήκουν πλέον στο target, ενώ τα διπλά
+	// keys του source και οι τιμές που αντικαταστάθηκαν καταστρέφονται (ο valgrind / ASan ελέγχει για leaks).
+	ShardedMap target = sharded_map_create(4, false, compare_ints, hash_int, free, free);
+	ShardedMap source = sharded_map_create(4, false, compare_ints, hash_int, free, free);
+	for (int i = 0; i < 200; i++) {
+		int* key = malloc(sizeof(*key));
+		int* value = malloc(sizeof(*value));
+		*key = *value = i;
+		sharded_map_insert(i < 100 ? target : source, key, value);
+
+		if (i >= 50 && i < 100) {		// τα keys 50..99 υπάρχουν και στα δύο
+			key = malloc(sizeof(*key));
+			value = malloc(sizeof(*value));
+			*key = i;
+			*value = -i;
+			sharded_map_insert(source, key, value);
+		}
+	}
+
+	sharded_map_merge(target, source, NULL);		// χωρίς merge, κρατάμε την τιμή του source
+	TEST_ASSERT(sharded_map_size(target) == 200);
+	for (int i = 0; i < 200; i++)
+		TEST_ASSERT(*(int*)sharded_map_find(target, &i) == (i >= 50 && i < 100 ? -i : i));
+
+	sharded_map_destroy(target);
+	sharded_map_destroy(source);
+}
+
+// Ταυτόχρονη μέτρηση: THREADS threads μετράνε τα ίδια keys, είτε σε κοινό locked map
+// είτε σε δικό τους map το καθένα, που στο τέλος συγχωνεύεται στο κοινό
+
+#define THREADS 4
+#define KEYS 1000
+#define ROUNDS 50
+
+struct count_arg {
+	ShardedMap shared;
+	int* ints;
+	bool private_map;
+};
+
+static void* count_main(void* arg) {
+	struct count_arg* count = arg;
+	ShardedMap map = count->private_map
+		? sharded_map_create(16, false, compare_ints, hash_int, NULL, NULL)
+		: count->shared;
+
+	for (int round = 0; round < ROUNDS; round++)
+		for (int i = 0; i < KEYS; i++)
+			sharded_map_update(map, &count->ints[i], increment);
+
+	if (count->private_map) {
+		sharded_map_merge(count->shared, map, add);
+		sharded_map_destroy(map);
+	}
+	return NULL;
+}
+
+void test_concurrent(void) {
+	int* ints = create_ints(KEYS);
+
+	for (int private_map = 0; private_map <= 1; private_map++) {
+		struct count_arg arg = {
+			.shared = sharded_map_create(16, true, compare_ints, hash_int, NULL, NULL),
+			.ints = ints,
+			.private_map = private_map,
+		};
+
+		pthread_t threads[THREADS];
+		for (int i = 0; i < THREADS; i++)
+			pthread_create(&threads[i], NULL, count_main, &arg);
+		for (int i = 0; i < THREADS; i++)
+			pthread_join(threads[i], NULL);
+
+		TEST_ASSERT(sharded_map_size(arg.shared) == KEYS);
+		for (int i = 0; i < KEYS; i++)
+			TEST_ASSERT((intptr_t)sharded_map_find(arg.shared, &ints[i]) == THREADS * ROUNDS);
+
+		sharded_map_destroy(arg.shared);
+	}
+
+	free(ints);
+}
+
+// Η sharded_map_update κάνει hash το key μία μόνο φορά (για την επιλογή του shard και για το ίδιο το shard)
+
+static int hash_calls = 0;
+
+static uint counting_hash(Pointer key) {
+	hash_calls++;
+	return hash_int(key);
+}
+
+void test_update_hashes_once(void) {
+	ShardedMap map = sharded_map_create(4, false, compare_ints, counting_hash, NULL, NULL);
+	int* ints = create_ints(10);
+
+	// Λίγα keys, ώστε κανένα shard να μη χρειαστεί rehash (που θα έκανε ξανά hash τα keys του)
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 10; i++) {
+			int calls = hash_calls;
+			sharded_map_update(map, &ints[i], increment);
+			TEST_ASSERT(hash_calls == calls + 1);
+		}
+	}
+	for (int i = 0; i < 10; i++)
+		TEST_ASSERT((intptr_t)sharded_map_find(map, &ints[i]) == 3);
+
+	sharded_map_destroy(map);
+	free(ints);
+}
+
+
+// Λίστα με όλα τα tests προς εκτέλεση
+TEST_LIST = {
+	{ "sharded_map_create", test_create },
+	{ "insert_find_remove", test_insert_find_remove },
+	{ "merge", test_merge },
+	{ "merge_destroy", test_merge_destroy },
+	{ "concurrent", test_concurrent },
+	{ "update_hashes_once", test_update_hashes_once },
+	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
+};
@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////
+//
+// Unit tests για τα typed maps (DEFINE_MAP) του ADTTypedMap.h
+//
+//////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "acutest.h"			// Απλή βιβλιοθήκη για unit testing
+
+#include "ADTTypedMap.h"
+
+
+DEFINE_MAP(IntIntMap, int, int, typed_map_hash_int, typed_map_equal_int)
+DEFINE_MAP(StringIntMap, const char*, int, typed_map_hash_string, typed_map_equal_string)
+
+
+void test_create(void) {
+	IntIntMap* map = IntIntMap_create();
+	TEST_ASSERT(map != NULL);
+	TEST_ASSERT(IntIntMap_size(map) == 0);
+	TEST_ASSERT(IntIntMap_find(map, 0) == NULL);
+	TEST_ASSERT(IntIntMap_first(map) == NULL);
+	IntIntMap_destroy(map);
+}
+
+void test_insert_find_remove(void) {
+	IntIntMap* map = IntIntMap_create();
+
+	// Αρκετά keys ώστε να γίνουν πολλά incremental rehash, τα οποία ελέγχουμε ενδιάμεσα
+	int N = 100000;
+	for (int i = 0; i < N; i++) {
+		IntIntMap_insert(map, i, 2 * i);
+		TEST_ASSERT(IntIntMap_size(map) == i + 1);
+		TEST_ASSERT(*IntIntMap_find(map, i) == 2 * i);
+		TEST_ASSERT(*IntIntMap_find(map, i / 2) == i / 2 * 2);
+	}
+
+	// Αντικατάσταση
+	for (int i = 0; i < N; i += 3)
+		IntIntMap_insert(map, i, -i);
+	TEST_ASSERT(IntIntMap_size(map) == N);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(*IntIntMap_find(map, i) == (i % 3 == 0 ? -i : 2 * i));
+	TEST_ASSERT(IntIntMap_find(map, N) == NULL);
+
+	// Διαγραφή των μισών, και εισαγωγή νέων (που καταλαμβάνουν DELETED κόμβους ή προκαλούν purge)
+	for (int i = 0; i < N; i += 2)
+		TEST_ASSERT(IntIntMap_remove(map, i));
+	TEST_ASSERT(!IntIntMap_remove(map, 0));
+	TEST_ASSERT(IntIntMap_size(map) == N / 2);
+
+	for (int i = N; i < 2 * N; i++)
+		IntIntMap_insert(map, i, i);
+	TEST_ASSERT(IntIntMap_size(map) == N / 2 + N);
+
+	for (int i = 0; i < 2 * N; i++) {
+		int* value = IntIntMap_find(map, i);
+		if (i < N && i % 2 == 0)
+			TEST_ASSERT(value == NULL);
+		else
+			TEST_ASSERT(value != NULL && *value == (i >= N ? i : i % 3 == 0 ? -i : 2 * i));
+	}
+
+	IntIntMap_destroy(map);
+}
+
+void test_iterate(void) {
+	IntIntMap* map = IntIntMap_create();
+
+	// Η διάσχιση πρέπει να επιστρέφει κάθε key ακριβώς μία φορά, και στη μέση ενός rehash
+	int N = 1000;
+	for (int i = 0; i < N; i++)
+		IntIntMap_insert(map, i, i);
+	TEST_ASSERT(map->old_array != NULL);
+
+	int* seen = calloc(N, sizeof(*seen));
+	int count = 0;
+	for (IntIntMapNode* node = IntIntMap_first(map); node != NULL; node = IntIntMap_next(map, node)) {
+		TEST_ASSERT(node->key >= 0 && node->key < N && node->key == node->value);
+		seen[node->key]++;
+		count++;
+	}
+	TEST_ASSERT(count == N);
+	for (int i = 0; i < N; i++)
+		TEST_ASSERT(seen[i] == 1);
+
+	free(seen);
+	IntIntMap_destroy(map);
+}
+
+void test_string_keys(void) {
+	StringIntMap* map = StringIntMap_create();
+
+	// Τα keys συγκρίνονται με το περιεχόμενο, οπότε αναζητούμε με διαφορετικά αντίγραφα
+	int N = 10000;
+	char** keys = malloc(N * sizeof(*keys));
+	for (int i = 0; i < N; i++) {
+		keys[i] = malloc(16);
+		sprintf(keys[i], "key_%d", i);
+		StringIntMap_insert(map, keys[i], i);
+	}
+
+	char buffer[16];
+	for (int i = 0; i < N; i++) {
+		sprintf(buffer, "key_%d", i);
+		int* value = StringIntMap_find(map, buffer);
+		TEST_ASSERT(value != NULL && *value == i);
+	}
+	TEST_ASSERT(StringIntMap_find(map, "missing") == NULL);
+	TEST_ASSERT(StringIntMap_remove(map, "key_0"));
+	TEST_ASSERT(StringIntMap_find(map, "key_0") == NULL);
+
+	StringIntMap_destroy(map);
+	for (int i = 0; i < N; i++)
+		free(keys[i]);
+	free(keys);
+}
+
+
+// Λίστα με όλα τα tests προς εκτέλεση
+TEST_LIST = {
+	{ "create", test_create },
+	{ "insert_find_remove", test_insert_find_remove },
+	{ "iterate", test_iterate },
+	{ "string_keys", test_string_keys },
+	{ NULL, NULL } // τερματίζουμε τη λίστα με NULL
+};